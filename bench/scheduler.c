@@ -0,0 +1,232 @@
+// Throughput benchmark of the work-stealing Scheduler against a thread pool
+// sharing a single mutex-guarded LinkedList of tasks, across worker counts.
+//
+// Each round submits a few root tasks which recursively split themselves
+// into small leaf tasks (like a parallel for loop would), so most of the
+// tasks are submitted from inside the workers.
+//
+// Build and run from the root of the repository:
+//
+//   gcc -O2 -pthread bench/scheduler.c lib/collections/*.c -lm -o scheduler_bench
+//   ./scheduler_bench [maxWorkers]
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include "../lib/collections/collections.h"
+#include "../lib/collections/scheduler.h"
+
+#define ROOT_TASKS 16
+#define LEAVES_PER_ROOT 65536
+#define LEAF_WORK 200
+
+/**
+ * The baseline: every worker pops from and pushes to the same locked list.
+ */
+typedef struct MutexPool
+{
+  LinkedList *tasks;
+  pthread_mutex_t lock;
+  pthread_t *threads;
+  size_t workerCount;
+  atomic_size_t pending;
+  atomic_bool stopping;
+} MutexPool;
+
+typedef struct Dispatcher
+{
+  const char *name;
+  void *(*create)(size_t workerCount);
+  void (*submit)(void *dispatcher, void (*taskFn)(void *argument), void *argument);
+  void (*wait)(void *dispatcher);
+  void (*destroy)(void *dispatcher);
+} Dispatcher;
+
+typedef struct Split
+{
+  void *dispatcher;
+  const Dispatcher *type;
+  size_t leaves;
+} Split;
+
+atomic_size_t checksum;
+
+// every task run, the split tree makes it hard to get right by hand
+atomic_size_t tasksRun;
+
+void *runMutexPoolWorker(void *argument)
+{
+  MutexPool *pool = argument;
+  while (!atomic_load(&pool->stopping))
+  {
+    pthread_mutex_lock(&pool->lock);
+    SchedulerTask *task = pool->tasks->removeBeg(pool->tasks);
+    pthread_mutex_unlock(&pool->lock);
+
+    if (task == NULL)
+    {
+      sched_yield();
+      continue;
+    }
+
+    task->taskFn(task->argument);
+    free(task);
+    atomic_fetch_sub(&pool->pending, 1);
+  }
+  return NULL;
+}
+
+void *createMutexPool(size_t workerCount)
+{
+  MutexPool *pool = malloc(sizeof(MutexPool));
+  pool->tasks = createLinkedList();
+  pthread_mutex_init(&pool->lock, NULL);
+  pool->workerCount = workerCount;
+  pool->threads = malloc(sizeof(pthread_t) * workerCount);
+  atomic_init(&pool->pending, 0);
+  atomic_init(&pool->stopping, false);
+  for (size_t i = 0; i < workerCount; i++)
+    pthread_create(&pool->threads[i], NULL, runMutexPoolWorker, pool);
+  return pool;
+}
+
+void submitMutexPool(void *dispatcher, void (*taskFn)(void *argument), void *argument)
+{
+  MutexPool *pool = dispatcher;
+  SchedulerTask *task = malloc(sizeof(SchedulerTask));
+  task->taskFn = taskFn;
+  task->argument = argument;
+  atomic_fetch_add(&pool->pending, 1);
+
+  pthread_mutex_lock(&pool->lock);
+  pool->tasks->append(pool->tasks, task);
+  pthread_mutex_unlock(&pool->lock);
+}
+
+void waitMutexPool(void *dispatcher)
+{
+  MutexPool *pool = dispatcher;
+  while (atomic_load(&pool->pending) != 0)
+    sched_yield();
+}
+
+void destroyMutexPool(void *dispatcher)
+{
+  MutexPool *pool = dispatcher;
+  waitMutexPool(pool);
+  atomic_store(&pool->stopping, true);
+  for (size_t i = 0; i < pool->workerCount; i++)
+    pthread_join(pool->threads[i], NULL);
+  pool->tasks->destroy(pool->tasks, free);
+  pthread_mutex_destroy(&pool->lock);
+  free(pool->threads);
+  free(pool);
+}
+
+void *createSchedulerDispatcher(size_t workerCount)
+{
+  return createScheduler(workerCount);
+}
+
+void submitSchedulerDispatcher(void *dispatcher, void (*taskFn)(void *argument), void *argument)
+{
+  Scheduler *scheduler = dispatcher;
+  scheduler->submit(scheduler, taskFn, argument);
+}
+
+void waitSchedulerDispatcher(void *dispatcher)
+{
+  Scheduler *scheduler = dispatcher;
+  scheduler->wait(scheduler);
+}
+
+void destroySchedulerDispatcher(void *dispatcher)
+{
+  Scheduler *scheduler = dispatcher;
+  scheduler->destroy(scheduler);
+}
+
+const Dispatcher dispatchers[] = {
+    {"mutex list", createMutexPool, submitMutexPool, waitMutexPool, destroyMutexPool},
+    {"work-stealing", createSchedulerDispatcher, submitSchedulerDispatcher, waitSchedulerDispatcher,
+     destroySchedulerDispatcher},
+};
+
+void leafTask(void *argument)
+{
+  atomic_fetch_add_explicit(&tasksRun, 1, memory_order_relaxed);
+
+  // a bit of work so the tasks aren't completely empty
+  uint64_t value = (uintptr_t)argument;
+  free(argument);
+  for (int i = 0; i < LEAF_WORK; i++)
+    value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+  atomic_fetch_add_explicit(&checksum, value & 1, memory_order_relaxed);
+}
+
+void splitTask(void *argument)
+{
+  atomic_fetch_add_explicit(&tasksRun, 1, memory_order_relaxed);
+
+  Split *split = argument;
+  if (split->leaves == 1)
+  {
+    split->type->submit(split->dispatcher, leafTask, split);
+    return;
+  }
+
+  // split in halves, reusing this split for the first half
+  Split *half = malloc(sizeof(Split));
+  *half = *split;
+  half->leaves = split->leaves / 2;
+  split->leaves -= half->leaves;
+  split->type->submit(split->dispatcher, splitTask, half);
+  split->type->submit(split->dispatcher, splitTask, split);
+}
+
+double now()
+{
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv)
+{
+  long cores = sysconf(_SC_NPROCESSORS_ONLN);
+  size_t maxWorkers = argc > 1 ? strtoul(argv[1], NULL, 10) : (size_t)(cores > 0 ? cores : 1);
+
+  printf("%-14s %8s %14s\n", "dispatcher", "workers", "tasks/s");
+  for (size_t d = 0; d < sizeof(dispatchers) / sizeof(dispatchers[0]); d++)
+  {
+    for (size_t workers = 1; workers <= maxWorkers; workers *= 2)
+    {
+      const Dispatcher *type = &dispatchers[d];
+      void *dispatcher = type->create(workers);
+
+      atomic_store_explicit(&tasksRun, 0, memory_order_relaxed);
+      double start = now();
+      for (size_t i = 0; i < ROOT_TASKS; i++)
+      {
+        Split *root = malloc(sizeof(Split));
+        root->dispatcher = dispatcher;
+        root->type = type;
+        root->leaves = LEAVES_PER_ROOT;
+        type->submit(dispatcher, splitTask, root);
+      }
+      type->wait(dispatcher);
+      double elapsed = now() - start;
+
+      // splitting N leaves runs 2N - 1 split tasks and N leaf tasks
+      size_t tasks = atomic_load_explicit(&tasksRun, memory_order_relaxed);
+      printf("%-14s %8zu %14.0f\n", type->name, workers, tasks / elapsed);
+      type->destroy(dispatcher);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,123 @@
+#include "arena.h"
+#include <stdlib.h>
+#include <string.h>
+
+size_t alignArena(size_t size);
+ArenaBlock *createArenaBlock(size_t size);
+
+void *alloc_Arena(Arena *arena, size_t size);
+void *realloc_Arena(Arena *arena, void *memory, size_t oldSize, size_t newSize);
+void reset_Arena(Arena *arena);
+void destroy_Arena(Arena *arena);
+
+Arena *createArena(size_t blockSize)
+{
+  Arena *arena = malloc(sizeof(Arena));
+  arena->blockSize = blockSize != 0 ? blockSize : ARENA_DEFAULT_BLOCK_SIZE;
+  arena->head = createArenaBlock(arena->blockSize);
+  arena->current = arena->head;
+  arena->last = NULL;
+
+  arena->alloc = alloc_Arena;
+  arena->realloc = realloc_Arena;
+  arena->reset = reset_Arena;
+  arena->destroy = destroy_Arena;
+  return arena;
+}
+
+void *allocIn(Arena *arena, size_t size)
+{
+  if (arena == NULL)
+    return malloc(size);
+  return arena->alloc(arena, size);
+}
+
+void freeIn(Arena *arena, void *memory)
+{
+  if (arena == NULL)
+    free(memory);
+}
+
+size_t alignArena(size_t size)
+{
+  size_t alignment = _Alignof(max_align_t);
+  return (size + alignment - 1) & ~(alignment - 1);
+}
+
+ArenaBlock *createArenaBlock(size_t size)
+{
+  ArenaBlock *block = malloc(sizeof(ArenaBlock) + size);
+  block->next = NULL;
+  block->size = size;
+  block->used = 0;
+  return block;
+}
+
+void *alloc_Arena(Arena *arena, size_t size)
+{
+  size = alignArena(size);
+
+  // move on to the next block when the current one is full, the blocks after
+  // the current one are always empty (either new or kept by a reset)
+  while (arena->current->used + size > arena->current->size)
+  {
+    ArenaBlock *next = arena->current->next;
+    if (next == NULL || size > next->size)
+    {
+      next = createArenaBlock(size > arena->blockSize ? size : arena->blockSize);
+      next->next = arena->current->next;
+      arena->current->next = next;
+    }
+
+    next->used = 0;
+    arena->current = next;
+  }
+
+  void *memory = arena->current->data + arena->current->used;
+  arena->current->used += size;
+  arena->last = memory;
+  return memory;
+}
+
+void *realloc_Arena(Arena *arena, void *memory, size_t oldSize, size_t newSize)
+{
+  if (memory == NULL)
+    return alloc_Arena(arena, newSize);
+  if (newSize <= oldSize)
+    return memory;
+
+  // Case: last allocation, grow it in place if the block has room for it
+  if (memory == arena->last)
+  {
+    size_t offset = (char *)memory - arena->current->data;
+    if (offset + alignArena(newSize) <= arena->current->size)
+    {
+      arena->current->used = offset + alignArena(newSize);
+      return memory;
+    }
+  }
+
+  // Case: somewhere else, move it (the old memory is wasted until reset)
+  void *reallocated = alloc_Arena(arena, newSize);
+  memcpy(reallocated, memory, oldSize);
+  return reallocated;
+}
+
+void reset_Arena(Arena *arena)
+{
+  arena->head->used = 0;
+  arena->current = arena->head;
+  arena->last = NULL;
+}
+
+void destroy_Arena(Arena *arena)
+{
+  ArenaBlock *block = arena->head;
+  while (block != NULL)
+  {
+    ArenaBlock *next = block->next;
+    free(block);
+    block = next;
+  }
+  free(arena);
+}
@@ -0,0 +1,110 @@
+#ifndef COLLECTIONS_ARENA_H
+#define COLLECTIONS_ARENA_H
+
+#include <stddef.h>
+
+/**
+ * The block size used when creating an arena with a block size of 0.
+ */
+#define ARENA_DEFAULT_BLOCK_SIZE 65536
+
+/**
+ * \struct ArenaBlock
+ * \brief A chunk of memory the arena allocates from.
+ */
+typedef struct ArenaBlock
+{
+  struct ArenaBlock *next;          /**< Pointer to the next block, NULL if it's the last one. */
+  size_t size;                      /**< Number of bytes the block can hold. */
+  size_t used;                      /**< Number of bytes already allocated from the block. */
+  _Alignas(max_align_t) char data[]; /**< The memory of the block. */
+} ArenaBlock;
+
+/**
+ * \struct Arena
+ * \brief A bump allocator which frees everything it allocated at once.
+ *
+ * Allocating is just bumping an offset in the current block, a new block is
+ * only allocated when the current one is full. Nothing is freed individually,
+ * resetting the arena releases everything in O(1) and keeps the blocks around
+ * to be reused.
+ *
+ * \warning An arena is not thread-safe.
+ */
+typedef struct Arena
+{
+  ArenaBlock *head;    /**< Pointer to the first block. */
+  ArenaBlock *current; /**< Pointer to the block currently allocated from. */
+  void *last;          /**< Pointer to the last allocation, which can grow in place. */
+  size_t blockSize;    /**< Minimum size of each new block. */
+
+  /**
+   * \brief Allocates memory from the arena.
+   * \param arena This arena.
+   * \param size The number of bytes to allocate.
+   * \return The allocated memory, aligned for any type.
+   * \warning Do NOT free the returned memory, reset the arena instead.
+   */
+  void *(*alloc)(struct Arena *arena, size_t size);
+
+  /**
+   * \brief Reallocates memory allocated from the arena.
+   *
+   * If the memory is the last allocation and the block still has room, it
+   * simply grows in place. Otherwise a new allocation is made and the old
+   * memory is wasted until the arena is reset.
+   *
+   * \param arena This arena.
+   * \param memory The memory to reallocate, can be NULL.
+   * \param oldSize The number of bytes the memory was allocated with.
+   * \param newSize The number of bytes to reallocate the memory to.
+   * \return The reallocated memory.
+   */
+  void *(*realloc)(struct Arena *arena, void *memory, size_t oldSize, size_t newSize);
+
+  /**
+   * \brief Releases everything allocated from the arena in O(1).
+   *
+   * The blocks are kept to be reused by the next allocations.
+   *
+   * \param arena This arena.
+   * \warning Every collection created in the arena is gone too, do not use
+   *          them after resetting the arena.
+   */
+  void (*reset)(struct Arena *arena);
+
+  /**
+   * \brief Frees the arena and all of its blocks from memory.
+   * \param arena This arena.
+   */
+  void (*destroy)(struct Arena *arena);
+} Arena;
+
+/**
+ * \brief Creates a new arena.
+ * \param blockSize The minimum size of each block the arena allocates, or 0
+ *                  to use ARENA_DEFAULT_BLOCK_SIZE.
+ * \return The new arena.
+ */
+Arena *createArena(size_t blockSize);
+
+/**
+ * \brief Allocates memory from an arena, or from the heap if there's no arena.
+ * \param arena The arena to allocate from, can be NULL.
+ * \param size The number of bytes to allocate.
+ * \return The allocated memory.
+ */
+void *allocIn(Arena *arena, size_t size);
+
+/**
+ * \brief Frees memory allocated by allocIn.
+ *
+ * Does nothing if the memory comes from an arena since it's released when
+ * the arena is reset.
+ *
+ * \param arena The arena the memory was allocated from, can be NULL.
+ * \param memory The memory to free.
+ */
+void freeIn(Arena *arena, void *memory);
+
+#endif // COLLECTIONS_ARENA_H
@@ -1,10 +1,16 @@
 #include "array.h"
 #include "dalloc.h"
+#include "iterator.h"
+#include "sort.h"
+#include "stringbuilder.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 
+void bindArray(Array *array);
 void dallocArray(Array *array);
+void detachArray(Array *array);
+void releaseArray(Array *array);
 void add_Array(Array *array, void *element);
 size_t indexOf_Array(Array *array, void *element);
 void *remove_Array(Array *array, void *element);
@@ -12,14 +18,34 @@ void *removeAt_Array(Array *array, size_t index);
 void removeAll_Array(Array *array, void (*destroyElementFn)(void *element));
 void insertAt_Array(Array *array, void *element, size_t index);
 void *at_Array(Array *array, size_t index);
+void reserve_Array(Array *array, size_t capacity);
+void radixSort_Array(Array *array, uint64_t (*keyFn)(void *element));
 char *toString_Array(Array *array, char *(*stringifyFn)(void *element));
+void appendTo_Array(Array *array, StringBuilder *builder, void (*appendElementFn)(StringBuilder *builder, void *element));
+Array *snapshot_Array(Array *array);
 void destroy_Array(Array *array, void (*destroyElementFn)(void *element));
 
 Array *createArray()
 {
-  Array *array = malloc(sizeof(Array));
+  return createArrayIn(NULL);
+}
+
+Array *createArrayIn(Arena *arena)
+{
+  Array *array = allocIn(arena, sizeof(Array));
+  array->arena = arena;
+  array->elements = NULL;
   array->size = 0;
+  array->allocSize = 0;
+  array->refCount = NULL;
+  STATS_RESET(array);
   dallocArray(array);
+  bindArray(array);
+  return array;
+}
+
+void bindArray(Array *array)
+{
   array->add = add_Array;
   array->indexOf = indexOf_Array;
   array->remove = remove_Array;
@@ -27,28 +53,83 @@ Array *createArray()
   array->removeAll = removeAll_Array;
   array->insertAt = insertAt_Array;
   array->at = at_Array;
+  array->reserve = reserve_Array;
+  array->radixSort = radixSort_Array;
+  array->iterator = createArrayIterator;
   array->toString = toString_Array;
+  array->appendTo = appendTo_Array;
+  array->snapshot = snapshot_Array;
   array->destroy = destroy_Array;
-  return array;
 }
 
 void dallocArray(Array *array)
 {
-  array->elements = dalloc(array->elements, sizeof(void *), array->size, array->allocSize);
+  size_t previousAllocSize = array->allocSize;
+  array->elements = dallocIn(array->arena, array->elements, sizeof(void *), array->size, array->allocSize);
+  if (array->allocSize != previousAllocSize)
+  {
+    STATS_ADD(array, allocations, 1);
+    STATS_ADD(array, bytesMoved, sizeof(void *) * array->size);
+  }
+}
+
+void detachArray(Array *array)
+{
+  if (array->refCount == NULL)
+    return;
+
+  // Case: the snapshots sharing the buffer are all gone, take it back
+  // (nobody else can take a new snapshot of it at this point)
+  if (atomic_load(array->refCount) == 1)
+  {
+    freeIn(array->arena, array->refCount);
+    array->refCount = NULL;
+    return;
+  }
+
+  // Case: the buffer is still shared, copy it before letting go of it
+  void **elements = allocIn(array->arena, sizeof(void *) * array->allocSize);
+  memcpy(elements, array->elements, sizeof(void *) * array->size);
+  STATS_ADD(array, allocations, 1);
+  STATS_ADD(array, bytesMoved, sizeof(void *) * array->size);
+  releaseArray(array);
+  array->elements = elements;
+  array->refCount = NULL;
+}
+
+void releaseArray(Array *array)
+{
+  // only the last array holding the buffer frees it
+  if (array->refCount == NULL || atomic_fetch_sub(array->refCount, 1) == 1)
+  {
+    freeIn(array->arena, array->elements);
+    freeIn(array->arena, array->refCount);
+  }
 }
 
 void add_Array(Array *array, void *element)
 {
-  dallocArray(array);
+  detachArray(array);
+  // only grow, never shrink on add so reserved space is kept
+  if (array->size >= array->allocSize)
+    dallocArray(array);
   array->elements[array->size] = element;
   array->size++;
+  STATS_ADD(array, adds, 1);
 }
 
 size_t indexOf_Array(Array *array, void *element)
 {
+  STATS_ADD(array, lookups, 1);
   for (size_t i = 0; i < array->size; i++)
+  {
     if (element == array->elements[i])
+    {
+      STATS_SCAN(array, i + 1);
       return i;
+    }
+  }
+  STATS_SCAN(array, array->size);
   return -1;
 }
 
@@ -60,6 +141,7 @@ void *remove_Array(Array *array, void *element)
   {
     if (array->elements[i] == element)
     {
+      detachArray(array);
       removedElement = element;
       j = i;
       continue;
@@ -70,11 +152,14 @@ void *remove_Array(Array *array, void *element)
     {
       array->elements[j] = array->elements[i];
       j++;
+      STATS_ADD(array, bytesMoved, sizeof(void *));
     }
   }
+  STATS_SCAN(array, array->size);
 
   if (removedElement != NULL)
   {
+    STATS_ADD(array, removes, 1);
     array->size--;
     array->elements[array->size] = NULL;
     dallocArray(array);
@@ -103,11 +188,14 @@ void removeAll_Array(Array *array, void (*destroyElementFn)(void *element))
 
 void insertAt_Array(Array *array, void *element, size_t index)
 {
-  dallocArray(array);
+  detachArray(array);
+  if (array->size >= array->allocSize)
+    dallocArray(array);
   array->size++;
 
   if (index >= array->size)
     index = array->size - 1;
+  STATS_ADD(array, inserts, 1);
 
   // FYI: if a size_t is decremented below 0, it becomes -1
   for (size_t i = array->size - 1; i != -1; i--)
@@ -120,56 +208,105 @@ void insertAt_Array(Array *array, void *element, size_t index)
 
     // shift the array until the new element is inserted
     array->elements[i] = array->elements[i - 1];
+    STATS_ADD(array, bytesMoved, sizeof(void *));
   }
 }
 
 void *at_Array(Array *array, size_t index)
 {
+  STATS_ADD(array, accesses, 1);
   if (index >= array->size)
     return NULL;
   return array->elements[index];
 }
 
-char *toString_Array(Array *array, char *(*stringifyFn)(void *element))
+void reserve_Array(Array *array, size_t capacity)
 {
-  if (stringifyFn == NULL)
-    return NULL;
+  if (capacity <= array->allocSize)
+    return;
 
-  // '[', ']', '\0' plus ", " for each element exluding the last element
-  size_t length = 1 + 1 + 1 + 2 * (array->size - 1);
+  // dalloc makes room for one more element than the current size
+  detachArray(array);
+  array->elements = dallocIn(array->arena, array->elements, sizeof(void *), capacity - 1, array->allocSize);
+  STATS_ADD(array, allocations, 1);
+  STATS_ADD(array, bytesMoved, sizeof(void *) * array->size);
+}
+
+void radixSort_Array(Array *array, uint64_t (*keyFn)(void *element))
+{
+  if (array->size < 2)
+    return;
 
-  // extract each stringified version of the elements
-  char **elementStrings = malloc(sizeof(char *) * array->size);
+  detachArray(array);
+  uint64_t *keys = malloc(sizeof(uint64_t) * array->size);
   for (size_t i = 0; i < array->size; i++)
-  {
-    elementStrings[i] = stringifyFn(array->elements[i]);
-    if (elementStrings[i] != NULL)
-      length += strlen(elementStrings[i]);
-  }
+    keys[i] = keyFn(array->elements[i]);
+  radixSortPairs(keys, array->elements, array->size);
+  free(keys);
+}
+
+char *toString_Array(Array *array, char *(*stringifyFn)(void *element))
+{
+  if (stringifyFn == NULL)
+    return NULL;
 
-  // build string array and also free the elements' strings
-  char *stringified = malloc(length);
-  strcpy(stringified, "[");
+  // build the string as we go and free each element's string right away
+  StringBuilder *builder = createStringBuilder();
+  builder->appendChar(builder, '[');
   for (size_t i = 0; i < array->size; i++)
   {
-    if (elementStrings[i] != NULL)
+    char *elementString = stringifyFn(array->elements[i]);
+    if (elementString != NULL)
     {
-      strcat(stringified, elementStrings[i]);
-      free(elementStrings[i]);
+      builder->append(builder, elementString);
+      free(elementString);
     }
 
     if (i != (array->size - 1))
-      strcat(stringified, ", ");
+      builder->append(builder, ", ");
   }
-  strcat(stringified, "]");
-  free(elementStrings);
+  builder->appendChar(builder, ']');
 
+  char *stringified = builder->toString(builder);
+  builder->destroy(builder);
   return stringified;
 }
 
+void appendTo_Array(Array *array, StringBuilder *builder, void (*appendElementFn)(StringBuilder *builder, void *element))
+{
+  builder->appendChar(builder, '[');
+  for (size_t i = 0; i < array->size; i++)
+  {
+    appendElementFn(builder, array->elements[i]);
+    if (i != (array->size - 1))
+      builder->append(builder, ", ");
+  }
+  builder->appendChar(builder, ']');
+}
+
+Array *snapshot_Array(Array *array)
+{
+  if (array->refCount == NULL)
+  {
+    array->refCount = allocIn(array->arena, sizeof(atomic_size_t));
+    atomic_init(array->refCount, 1);
+  }
+  atomic_fetch_add(array->refCount, 1);
+
+  // the snapshot is a shallow copy pointing to the same buffer
+  Array *snapshot = allocIn(array->arena, sizeof(Array));
+  *snapshot = *array;
+  STATS_RESET(snapshot);
+  return snapshot;
+}
+
 void destroy_Array(Array *array, void (*destroyElementFn)(void *element))
 {
-  removeAll_Array(array, destroyElementFn);
-  free(array->elements);
-  free(array);
+  // no need to remove each element one by one (which would also copy a shared
+  // buffer for nothing), just destroy them then let go of the buffer
+  if (destroyElementFn != NULL)
+    for (size_t i = array->size; i-- > 0;)
+      destroyElementFn(array->elements[i]);
+  releaseArray(array);
+  freeIn(array->arena, array);
 }
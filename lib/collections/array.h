@@ -2,16 +2,35 @@
 #define COLLECTIONS_ARRAY_H
 
 #include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include "stats.h"
+#include "arena.h"
+
+struct Iterator;
+struct StringBuilder;
 
 /**
  * An Array collection.
  */
 typedef struct Array
 {
+  Arena *arena;     /**< The arena the array allocates from, NULL for the heap. */
   void **elements;  /**< Pointer to the array elements. */
   size_t size;      /**< Number of elements in the array. */
   size_t allocSize; /**< Total allocated size for the array. */
 
+  /**
+   * Number of arrays sharing the elements buffer. Non-NULL once a snapshot
+   * has been taken, until the next write after all the snapshots are gone
+   * (the count is then 1).
+   */
+  atomic_size_t *refCount;
+
+#ifdef COLLECTIONS_STATS
+  CollectionStats stats; /**< Counters of the operations done on the array. */
+#endif
+
   /**
    * \brief Adds a new element to the array.
    * \param array This array.
@@ -83,6 +102,39 @@ typedef struct Array
    */
   void *(*at)(struct Array *array, size_t index);
 
+  /**
+   * \brief Reserves space for at least the given number of elements.
+   *
+   * Adding elements up to the reserved capacity won't reallocate the array.
+   * The space is given back once elements are removed from the array.
+   *
+   * \param array This array.
+   * \param capacity The number of elements the array must be able to hold.
+   */
+  void (*reserve)(struct Array *array, size_t capacity);
+
+  /**
+   * \brief Sorts the array by an integer key of each element.
+   *
+   * Uses an LSD radix sort which is O(n) and never compares two elements, the
+   * key of each element is only extracted once. The sort is stable.
+   *
+   * To sort by a signed key, flip its sign bit (key ^ (1ULL << 63)) so the
+   * negative keys come before the positive ones.
+   *
+   * \param array This array.
+   * \param keyFn The function returning the key of each element.
+   */
+  void (*radixSort)(struct Array *array, uint64_t (*keyFn)(void *element));
+
+  /**
+   * \brief Creates a lazy iterator over the elements of the array.
+   * \param array This array.
+   * \return The new iterator.
+   * \warning It is up to the caller to destroy the iterator.
+   */
+  struct Iterator *(*iterator)(struct Array *array);
+
   /**
    * \brief Stringifies the array.
    *
@@ -98,6 +150,42 @@ typedef struct Array
    */
   char *(*toString)(struct Array *array, char *(*stringifyFn)(void *element));
 
+  /**
+   * \brief Stringifies the array into a string builder.
+   *
+   * Unlike toString, the appendElementFn writes each element straight into
+   * the builder so nothing is allocated for each element.
+   *
+   * \param array This array.
+   * \param builder The string builder to append to.
+   * \param appendElementFn A function appending the string version of an
+   *                        element to the builder.
+   */
+  void (*appendTo)(struct Array *array, struct StringBuilder *builder,
+                   void (*appendElementFn)(struct StringBuilder *builder, void *element));
+
+  /**
+   * \brief Takes an immutable snapshot of the array in O(1).
+   *
+   * The snapshot shares the elements buffer with the array. The buffer is only
+   * copied when either of them is modified for the first time after the
+   * snapshot was taken (copy-on-write), so the snapshot can be read from
+   * another thread while the original array keeps on being modified.
+   *
+   * The snapshot is itself an Array, it can be modified too (it will copy the
+   * buffer as well) and it must be destroyed like any other array.
+   *
+   * \param array This array.
+   * \return The snapshot of the array.
+   * \warning Only the buffer is copied, not the elements. Do not pass a
+   *          destroyElementFn when destroying either the array or the
+   *          snapshot while the other one still uses the elements.
+   * \warning The snapshot must be taken by the thread modifying the array (or
+   *          while holding its lock), reading and destroying it afterwards
+   *          can be done from any thread.
+   */
+  struct Array *(*snapshot)(struct Array *array);
+
   /**
    * \brief Frees the array from memory.
    *
@@ -120,4 +208,16 @@ typedef struct Array
  */
 Array *createArray();
 
+/**
+ * \brief Create a new Array collection allocated from an arena.
+ *
+ * The array and its elements buffer are allocated from the arena so they are
+ * all released at once when the arena is reset, there's no need to destroy
+ * the array (unless its elements must be destroyed).
+ *
+ * \param arena The arena to allocate from, if NULL the heap is used.
+ * \return The new Array collection.
+ */
+Array *createArrayIn(Arena *arena);
+
 #endif // COLLECTIONS_ARRAY_H
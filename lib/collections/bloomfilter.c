@@ -0,0 +1,204 @@
+#include "bloomfilter.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define BLOOM_FILTER_MAGIC 0x4d4f4c42 // "BLOM"
+#define BLOOM_FILTER_MAX_HASHES 16
+#define BLOOM_FILTER_BLOCK_OVERHEAD 0.006
+
+/**
+ * The header of a serialized filter, followed by its blocks.
+ */
+typedef struct BloomFilterHeader
+{
+  uint32_t magic;
+  uint32_t hashCount;
+  uint64_t blockCount;
+  uint64_t size;
+} BloomFilterHeader;
+
+BloomFilter *allocBloomFilter(size_t blockCount, size_t hashCount, size_t (*hashFn)(void *element));
+uint64_t mixBloomFilter(uint64_t hash);
+uint64_t *blockBloomFilter(BloomFilter *filter, uint64_t hash);
+void maskBloomFilter(BloomFilter *filter, uint64_t hash, uint64_t *mask);
+
+void add_BloomFilter(BloomFilter *filter, void *element);
+void addAll_BloomFilter(BloomFilter *filter, void **elements, size_t count);
+bool mightContain_BloomFilter(BloomFilter *filter, void *element);
+void clear_BloomFilter(BloomFilter *filter);
+void *serialize_BloomFilter(BloomFilter *filter, size_t *length);
+void destroy_BloomFilter(BloomFilter *filter);
+
+BloomFilter *createBloomFilter(size_t expectedElements, double falsePositiveRate, size_t (*hashFn)(void *element))
+{
+  if (expectedElements == 0)
+    expectedElements = 1;
+  if (falsePositiveRate <= 0 || falsePositiveRate >= 1)
+    falsePositiveRate = 0.01;
+
+  // optimal number of bits m = -n ln(p) / ln(2)^2 and hashes k = m / n ln(2)
+  double ln2 = log(2);
+  double bits = -(double)expectedElements * log(falsePositiveRate) / (ln2 * ln2);
+  size_t hashCount = (size_t)round(bits / expectedElements * ln2);
+
+  // keeping an element's bits in one block makes some blocks fuller than
+  // others, more bits (the more hashes, the more bits) bring the rate back
+  // to the wanted one
+  bits *= 1 + BLOOM_FILTER_BLOCK_OVERHEAD * hashCount * hashCount;
+  size_t blockCount = (size_t)ceil(bits / BLOOM_FILTER_BLOCK_BITS);
+  if (blockCount == 0)
+    blockCount = 1;
+  if (hashCount == 0)
+    hashCount = 1;
+  if (hashCount > BLOOM_FILTER_MAX_HASHES)
+    hashCount = BLOOM_FILTER_MAX_HASHES;
+
+  BloomFilter *filter = allocBloomFilter(blockCount, hashCount, hashFn);
+  if (filter != NULL)
+    clear_BloomFilter(filter);
+  return filter;
+}
+
+BloomFilter *deserializeBloomFilter(const void *buffer, size_t length, size_t (*hashFn)(void *element))
+{
+  BloomFilterHeader header;
+  if (length < sizeof(BloomFilterHeader))
+    return NULL;
+  memcpy(&header, buffer, sizeof(BloomFilterHeader));
+
+  // the buffer may come from anywhere, don't let a huge block count wrap the length around
+  if (header.magic != BLOOM_FILTER_MAGIC || header.blockCount == 0 ||
+      header.blockCount > (SIZE_MAX - sizeof(BloomFilterHeader)) / (BLOOM_FILTER_BLOCK_BITS / 8) ||
+      header.hashCount == 0 || header.hashCount > BLOOM_FILTER_MAX_HASHES)
+    return NULL;
+
+  size_t blocksLength = header.blockCount * (BLOOM_FILTER_BLOCK_BITS / 8);
+  if (length != sizeof(BloomFilterHeader) + blocksLength)
+    return NULL;
+
+  BloomFilter *filter = allocBloomFilter(header.blockCount, header.hashCount, hashFn);
+  if (filter == NULL)
+    return NULL;
+  memcpy(filter->blocks, (const char *)buffer + sizeof(BloomFilterHeader), blocksLength);
+  filter->size = header.size;
+  return filter;
+}
+
+BloomFilter *allocBloomFilter(size_t blockCount, size_t hashCount, size_t (*hashFn)(void *element))
+{
+  BloomFilter *filter = malloc(sizeof(BloomFilter));
+  filter->blockCount = blockCount;
+  filter->hashCount = hashCount;
+  filter->size = 0;
+  filter->hashFn = hashFn;
+
+  // align the blocks on cache lines
+  filter->blocks = aligned_alloc(BLOOM_FILTER_BLOCK_BITS / 8, blockCount * (BLOOM_FILTER_BLOCK_BITS / 8));
+  if (filter->blocks == NULL)
+  {
+    free(filter);
+    return NULL;
+  }
+
+  filter->add = add_BloomFilter;
+  filter->addAll = addAll_BloomFilter;
+  filter->mightContain = mightContain_BloomFilter;
+  filter->clear = clear_BloomFilter;
+  filter->serialize = serialize_BloomFilter;
+  filter->destroy = destroy_BloomFilter;
+  return filter;
+}
+
+uint64_t mixBloomFilter(uint64_t hash)
+{
+  // spread weak user hashes (e.g. pointers) over all the bits
+  hash ^= hash >> 30;
+  hash *= 0xbf58476d1ce4e5b9ULL;
+  hash ^= hash >> 27;
+  hash *= 0x94d049bb133111ebULL;
+  hash ^= hash >> 31;
+  return hash;
+}
+
+uint64_t *blockBloomFilter(BloomFilter *filter, uint64_t hash)
+{
+  // map the high bits to a block without a division
+  size_t block = (size_t)(((hash >> 32) * filter->blockCount) >> 32);
+  return &filter->blocks[block * BLOOM_FILTER_BLOCK_WORDS];
+}
+
+void maskBloomFilter(BloomFilter *filter, uint64_t hash, uint64_t *mask)
+{
+  // derive the k bits inside the block from the low bits (double hashing)
+  uint32_t first = (uint32_t)hash;
+  uint32_t step = (uint32_t)(hash >> 32) | 1;
+
+  memset(mask, 0, sizeof(uint64_t) * BLOOM_FILTER_BLOCK_WORDS);
+  for (size_t i = 0; i < filter->hashCount; i++)
+  {
+    uint32_t bit = (first + (uint32_t)i * step) % BLOOM_FILTER_BLOCK_BITS;
+    mask[bit / 64] |= (uint64_t)1 << (bit % 64);
+  }
+}
+
+void add_BloomFilter(BloomFilter *filter, void *element)
+{
+  uint64_t hash = mixBloomFilter(filter->hashFn(element));
+  uint64_t mask[BLOOM_FILTER_BLOCK_WORDS];
+  maskBloomFilter(filter, hash, mask);
+
+  uint64_t *block = blockBloomFilter(filter, hash);
+  for (size_t i = 0; i < BLOOM_FILTER_BLOCK_WORDS; i++)
+    block[i] |= mask[i];
+  filter->size++;
+}
+
+void addAll_BloomFilter(BloomFilter *filter, void **elements, size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+    add_BloomFilter(filter, elements[i]);
+}
+
+bool mightContain_BloomFilter(BloomFilter *filter, void *element)
+{
+  uint64_t hash = mixBloomFilter(filter->hashFn(element));
+  uint64_t mask[BLOOM_FILTER_BLOCK_WORDS];
+  maskBloomFilter(filter, hash, mask);
+
+  // check the whole block at once instead of bit by bit
+  uint64_t *block = blockBloomFilter(filter, hash);
+  uint64_t missing = 0;
+  for (size_t i = 0; i < BLOOM_FILTER_BLOCK_WORDS; i++)
+    missing |= mask[i] & ~block[i];
+  return missing == 0;
+}
+
+void clear_BloomFilter(BloomFilter *filter)
+{
+  memset(filter->blocks, 0, filter->blockCount * BLOOM_FILTER_BLOCK_BITS / 8);
+  filter->size = 0;
+}
+
+void *serialize_BloomFilter(BloomFilter *filter, size_t *length)
+{
+  BloomFilterHeader header;
+  memset(&header, 0, sizeof(BloomFilterHeader));
+  header.magic = BLOOM_FILTER_MAGIC;
+  header.hashCount = filter->hashCount;
+  header.blockCount = filter->blockCount;
+  header.size = filter->size;
+
+  size_t blocksLength = filter->blockCount * BLOOM_FILTER_BLOCK_BITS / 8;
+  *length = sizeof(BloomFilterHeader) + blocksLength;
+  char *buffer = malloc(*length);
+  memcpy(buffer, &header, sizeof(BloomFilterHeader));
+  memcpy(buffer + sizeof(BloomFilterHeader), filter->blocks, blocksLength);
+  return buffer;
+}
+
+void destroy_BloomFilter(BloomFilter *filter)
+{
+  free(filter->blocks);
+  free(filter);
+}
@@ -0,0 +1,107 @@
+#ifndef COLLECTIONS_BLOOMFILTER_H
+#define COLLECTIONS_BLOOMFILTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Number of bits in each block of a BloomFilter (one 64-byte cache line).
+ */
+#define BLOOM_FILTER_BLOCK_BITS 512
+
+/**
+ * Number of 64-bit words in each block of a BloomFilter.
+ */
+#define BLOOM_FILTER_BLOCK_WORDS (BLOOM_FILTER_BLOCK_BITS / 64)
+
+/**
+ * \struct BloomFilter
+ * \brief A blocked Bloom filter telling if an element is definitely absent.
+ *
+ * All the bits of an element are set inside a single 64-byte block so
+ * checking an element only touches one cache line. The filter can return
+ * false positives (at the configured rate) but never false negatives.
+ *
+ * The elements themselves are NOT stored, only their hashes.
+ */
+typedef struct BloomFilter
+{
+  uint64_t *blocks;  /**< The bits of the filter, BLOOM_FILTER_BLOCK_WORDS words per block. */
+  size_t blockCount; /**< Number of blocks. */
+  size_t hashCount;  /**< Number of bits set per element. */
+  size_t size;       /**< Number of elements added. */
+
+  size_t (*hashFn)(void *element); /**< Returns the hash of an element. */
+
+  /**
+   * \brief Adds an element to the filter.
+   * \param filter This filter.
+   * \param element The element to add.
+   */
+  void (*add)(struct BloomFilter *filter, void *element);
+
+  /**
+   * \brief Adds many elements to the filter.
+   * \param filter This filter.
+   * \param elements The elements to add (e.g. the elements of an Array).
+   * \param count The number of elements to add.
+   */
+  void (*addAll)(struct BloomFilter *filter, void **elements, size_t count);
+
+  /**
+   * \brief Checks if an element might have been added to the filter.
+   * \param filter This filter.
+   * \param element The element to check.
+   * \return false if the element was definitely never added, true if it
+   *         probably was.
+   */
+  bool (*mightContain)(struct BloomFilter *filter, void *element);
+
+  /**
+   * \brief Removes all the elements from the filter.
+   * \param filter This filter.
+   */
+  void (*clear)(struct BloomFilter *filter);
+
+  /**
+   * \brief Serializes the filter into a flat buffer.
+   * \param filter This filter.
+   * \param length Where to store the length of the buffer in bytes.
+   * \return The buffer, to be read back with deserializeBloomFilter.
+   * \warning It is up to the caller to free the buffer.
+   * \warning The buffer is in the byte order of the machine.
+   */
+  void *(*serialize)(struct BloomFilter *filter, size_t *length);
+
+  /**
+   * \brief Frees the filter from memory.
+   * \param filter This filter.
+   */
+  void (*destroy)(struct BloomFilter *filter);
+} BloomFilter;
+
+/**
+ * \brief Creates a new empty Bloom filter.
+ * \param expectedElements The number of elements expected to be added.
+ * \param falsePositiveRate The wanted probability of false positives once
+ *                          the expected elements are added (e.g. 0.01).
+ *                          Rates under 0.001 are only approached since
+ *                          the bits of an element must fit in one block.
+ * \param hashFn Returns the hash of an element.
+ * \return The new Bloom filter, or NULL if its blocks can't be allocated.
+ */
+BloomFilter *createBloomFilter(size_t expectedElements, double falsePositiveRate, size_t (*hashFn)(void *element));
+
+/**
+ * \brief Creates a Bloom filter from a buffer returned by serialize.
+ * \param buffer The serialized filter.
+ * \param length The length of the buffer in bytes.
+ * \param hashFn Returns the hash of an element, must be the same function the
+ *               filter was built with.
+ * \return The Bloom filter, or NULL if the buffer is not a valid filter or
+ *         its blocks can't be allocated.
+ */
+BloomFilter *deserializeBloomFilter(const void *buffer, size_t length, size_t (*hashFn)(void *element));
+
+#endif // COLLECTIONS_BLOOMFILTER_H
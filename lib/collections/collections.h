@@ -1,7 +1,16 @@
 #ifndef COLLECTIONS_H
 #define COLLECTIONS_H
 
+#include "arena.h"
 #include "array.h"
+#include "bloomfilter.h"
 #include "linkedlist.h"
+#include "lrucache.h"
+#include "radixtree.h"
+#include "iterator.h"
+#include "sort.h"
+#include "stringbuilder.h"
+#include "stringpool.h"
+#include "workdeque.h"
 
 #endif // COLLECTIONS_H
@@ -4,8 +4,14 @@
 #include <math.h>
 
 void *_dalloc(void *memory, size_t elementSize, size_t currentSize, size_t *allocSize)
+{
+  return _dallocIn(NULL, memory, elementSize, currentSize, allocSize);
+}
+
+void *_dallocIn(Arena *arena, void *memory, size_t elementSize, size_t currentSize, size_t *allocSize)
 {
   bool toReallocate = false;
+  size_t previousAllocSize = memory != NULL ? *allocSize : 0;
 
   if (currentSize == 0)
   {
@@ -18,10 +24,12 @@ void *_dalloc(void *memory, size_t elementSize, size_t currentSize, size_t *allo
   // second condition: reallocate maximizing space to contain new size limit
   if (currentSize < ((*allocSize) / 2) || currentSize >= *allocSize)
   {
-    *allocSize = pow(2, ceil(log2(currentSize)));
+    *allocSize = pow(2, ceil(log2(currentSize + 1)));
     toReallocate = true;
   }
 
+  if (toReallocate && arena != NULL)
+    return arena->realloc(arena, memory, elementSize * previousAllocSize, elementSize * (*allocSize));
   if (toReallocate)
     return realloc(memory, elementSize * (*allocSize));
 
@@ -2,6 +2,7 @@
 #define DALLOC_H
 
 #include <stddef.h>
+#include "arena.h"
 
 /**
  * \brief A macro to the original dalloc function to avoid using '&' for the
@@ -40,4 +41,30 @@
  */
 void *_dalloc(void *memory, size_t elementSize, size_t currentSize, size_t *allocSize);
 
+/**
+ * \brief A macro to the original dallocIn function to avoid using '&' for the
+ *        allocation size.
+ *
+ * Same as dalloc but the array is reallocated from the given arena (or from
+ * the heap if the arena is NULL).
+ */
+#define dallocIn(arena, memory, elementSize, currentSize, allocSize) _dallocIn(arena, memory, elementSize, currentSize, &allocSize);
+
+/**
+ * \brief Dynamically reallocate an array from an arena.
+ *
+ * Same as _dalloc but the array is reallocated from the given arena. The
+ * space given back when shrinking is only reclaimed when the arena is reset.
+ *
+ * \param arena The arena to reallocate from, if NULL the heap is used.
+ * \param memory The array to reallocate.
+ * \param elementSize The size of each element in the array.
+ * \param currentSize The current size of the array.
+ * \param allocSize A pointer to the allocation size of the array.
+ * \return The reallocated array.
+ * \warning The current size is not incremented, it is up to the caller to
+ *          increment it.
+ */
+void *_dallocIn(Arena *arena, void *memory, size_t elementSize, size_t currentSize, size_t *allocSize);
+
 #endif // DALLOC_H
@@ -0,0 +1,236 @@
+#include "iterator.h"
+#include <stdlib.h>
+
+Iterator *createIterator(IteratorKind kind, Iterator *source);
+
+bool next_Iterator(Iterator *iterator, void **element);
+void sizeHint_Iterator(Iterator *iterator, size_t *lower, size_t *upper);
+Iterator *filter_Iterator(Iterator *iterator, bool (*predicateFn)(void *element));
+Iterator *map_Iterator(Iterator *iterator, void *(*mapFn)(void *element));
+Iterator *take_Iterator(Iterator *iterator, size_t count);
+Iterator *skip_Iterator(Iterator *iterator, size_t count);
+void collectIntoArray_Iterator(Iterator *iterator, Array *array);
+void collectIntoLinkedList_Iterator(Iterator *iterator, LinkedList *list);
+void *reduce_Iterator(Iterator *iterator, void *accumulator, void *(*reduceFn)(void *accumulator, void *element));
+void destroy_Iterator(Iterator *iterator);
+
+Iterator *createArrayIterator(Array *array)
+{
+  Iterator *iterator = createIterator(ITERATOR_ARRAY, NULL);
+  iterator->cursor = array;
+  return iterator;
+}
+
+Iterator *createLinkedListIterator(LinkedList *list)
+{
+  Iterator *iterator = createIterator(ITERATOR_LINKED_LIST, NULL);
+  iterator->cursor = list->head;
+  iterator->count = list->size;
+  return iterator;
+}
+
+Iterator *createIterator(IteratorKind kind, Iterator *source)
+{
+  Iterator *iterator = malloc(sizeof(Iterator));
+  iterator->kind = kind;
+  iterator->source = source;
+  iterator->cursor = NULL;
+  iterator->index = 0;
+  iterator->count = 0;
+  iterator->predicateFn = NULL;
+  iterator->mapFn = NULL;
+
+  iterator->next = next_Iterator;
+  iterator->sizeHint = sizeHint_Iterator;
+  iterator->filter = filter_Iterator;
+  iterator->map = map_Iterator;
+  iterator->take = take_Iterator;
+  iterator->skip = skip_Iterator;
+  iterator->collectIntoArray = collectIntoArray_Iterator;
+  iterator->collectIntoLinkedList = collectIntoLinkedList_Iterator;
+  iterator->reduce = reduce_Iterator;
+  iterator->destroy = destroy_Iterator;
+  return iterator;
+}
+
+bool next_Iterator(Iterator *iterator, void **element)
+{
+  switch (iterator->kind)
+  {
+  case ITERATOR_ARRAY:
+  {
+    Array *array = iterator->cursor;
+    if (iterator->index >= array->size)
+      return false;
+    *element = array->elements[iterator->index++];
+    return true;
+  }
+
+  case ITERATOR_LINKED_LIST:
+  {
+    LinkedNode *node = iterator->cursor;
+    if (node == NULL)
+      return false;
+    *element = node->value;
+    iterator->cursor = node->next;
+    iterator->count--;
+    return true;
+  }
+
+  case ITERATOR_FILTER:
+  {
+    void *candidate;
+    while (iterator->source->next(iterator->source, &candidate))
+    {
+      if (iterator->predicateFn(candidate))
+      {
+        *element = candidate;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  case ITERATOR_MAP:
+  {
+    void *original;
+    if (!iterator->source->next(iterator->source, &original))
+      return false;
+    *element = iterator->mapFn(original);
+    return true;
+  }
+
+  case ITERATOR_TAKE:
+    // don't pull from the source once done, it might do work for nothing
+    if (iterator->index >= iterator->count)
+      return false;
+    if (!iterator->source->next(iterator->source, element))
+      return false;
+    iterator->index++;
+    return true;
+
+  case ITERATOR_SKIP:
+  {
+    void *skipped;
+    for (; iterator->index < iterator->count; iterator->index++)
+      if (!iterator->source->next(iterator->source, &skipped))
+        return false;
+    return iterator->source->next(iterator->source, element);
+  }
+  }
+
+  return false;
+}
+
+void sizeHint_Iterator(Iterator *iterator, size_t *lower, size_t *upper)
+{
+  switch (iterator->kind)
+  {
+  case ITERATOR_ARRAY:
+  {
+    Array *array = iterator->cursor;
+    *lower = *upper = iterator->index < array->size ? array->size - iterator->index : 0;
+    return;
+  }
+
+  case ITERATOR_LINKED_LIST:
+    *lower = *upper = iterator->count;
+    return;
+
+  case ITERATOR_FILTER:
+    // anything from none to all of the source's elements can match
+    iterator->source->sizeHint(iterator->source, lower, upper);
+    *lower = 0;
+    return;
+
+  case ITERATOR_MAP:
+    iterator->source->sizeHint(iterator->source, lower, upper);
+    return;
+
+  case ITERATOR_TAKE:
+  {
+    size_t left = iterator->count - iterator->index;
+    iterator->source->sizeHint(iterator->source, lower, upper);
+    *lower = *lower < left ? *lower : left;
+    *upper = *upper < left ? *upper : left;
+    return;
+  }
+
+  case ITERATOR_SKIP:
+  {
+    size_t left = iterator->count - iterator->index;
+    iterator->source->sizeHint(iterator->source, lower, upper);
+    *lower = *lower > left ? *lower - left : 0;
+    *upper = *upper > left ? *upper - left : 0;
+    return;
+  }
+  }
+
+  *lower = *upper = 0;
+}
+
+Iterator *filter_Iterator(Iterator *iterator, bool (*predicateFn)(void *element))
+{
+  Iterator *filter = createIterator(ITERATOR_FILTER, iterator);
+  filter->predicateFn = predicateFn;
+  return filter;
+}
+
+Iterator *map_Iterator(Iterator *iterator, void *(*mapFn)(void *element))
+{
+  Iterator *map = createIterator(ITERATOR_MAP, iterator);
+  map->mapFn = mapFn;
+  return map;
+}
+
+Iterator *take_Iterator(Iterator *iterator, size_t count)
+{
+  Iterator *take = createIterator(ITERATOR_TAKE, iterator);
+  take->count = count;
+  return take;
+}
+
+Iterator *skip_Iterator(Iterator *iterator, size_t count)
+{
+  Iterator *skip = createIterator(ITERATOR_SKIP, iterator);
+  skip->count = count;
+  return skip;
+}
+
+void collectIntoArray_Iterator(Iterator *iterator, Array *array)
+{
+  // reserve what's sure to come at once, reserving the upper bound would
+  // keep a selective filter's result as big as its source
+  size_t lower, upper;
+  iterator->sizeHint(iterator, &lower, &upper);
+  array->reserve(array, array->size + lower);
+
+  void *element;
+  while (iterator->next(iterator, &element))
+    array->add(array, element);
+}
+
+void collectIntoLinkedList_Iterator(Iterator *iterator, LinkedList *list)
+{
+  void *element;
+  while (iterator->next(iterator, &element))
+    list->append(list, element);
+}
+
+void *reduce_Iterator(Iterator *iterator, void *accumulator, void *(*reduceFn)(void *accumulator, void *element))
+{
+  void *element;
+  while (iterator->next(iterator, &element))
+    accumulator = reduceFn(accumulator, element);
+  return accumulator;
+}
+
+void destroy_Iterator(Iterator *iterator)
+{
+  while (iterator != NULL)
+  {
+    Iterator *source = iterator->source;
+    free(iterator);
+    iterator = source;
+  }
+}
@@ -0,0 +1,147 @@
+#ifndef COLLECTIONS_ITERATOR_H
+#define COLLECTIONS_ITERATOR_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "array.h"
+#include "linkedlist.h"
+
+/**
+ * \brief The kind of an iterator, that is, where it takes its elements from.
+ */
+typedef enum IteratorKind
+{
+  ITERATOR_ARRAY,       /**< Iterates over an Array. */
+  ITERATOR_LINKED_LIST, /**< Iterates over a LinkedList. */
+  ITERATOR_FILTER,      /**< Skips the source's elements not matching a predicate. */
+  ITERATOR_MAP,         /**< Transforms each of the source's elements. */
+  ITERATOR_TAKE,        /**< Stops after a number of the source's elements. */
+  ITERATOR_SKIP         /**< Skips a number of the source's first elements. */
+} IteratorKind;
+
+/**
+ * \struct Iterator
+ * \brief A lazy iterator over the elements of a collection.
+ *
+ * Iterators can be chained with filter, map, take and skip without
+ * materializing any intermediate collection, the elements are only pulled
+ * one at a time from the collection when the iterator is consumed.
+ *
+ * \warning The collection must not be modified while it is being iterated.
+ */
+typedef struct Iterator
+{
+  IteratorKind kind;       /**< Where this iterator takes its elements from. */
+  struct Iterator *source; /**< The iterator this one pulls from, NULL if it iterates over a collection. */
+  void *cursor;            /**< The collection (Array) or the next node (LinkedList) to iterate. */
+  size_t index;            /**< The next index (Array) or the number of elements taken/skipped so far. */
+  size_t count;            /**< The number of elements to take/skip, or the remaining size of the collection. */
+
+  bool (*predicateFn)(void *element); /**< The predicate of a filter iterator. */
+  void *(*mapFn)(void *element);      /**< The transformation of a map iterator. */
+
+  /**
+   * \brief Pulls the next element of the iterator.
+   * \param iterator This iterator.
+   * \param element Where to store the next element.
+   * \return true if there was a next element, false if the iterator is
+   *         exhausted (element is left untouched).
+   */
+  bool (*next)(struct Iterator *iterator, void **element);
+
+  /**
+   * \brief Returns the bounds of the number of elements left.
+   * \param iterator This iterator.
+   * \param lower Where to store the minimum number of elements this iterator
+   *              will still return.
+   * \param upper Where to store the maximum number of elements this iterator
+   *              can still return.
+   */
+  void (*sizeHint)(struct Iterator *iterator, size_t *lower, size_t *upper);
+
+  /**
+   * \brief Keeps only the elements matching the given predicate.
+   * \param iterator This iterator, now owned by the returned iterator.
+   * \param predicateFn Returns true for the elements to keep.
+   * \return The new chained iterator.
+   */
+  struct Iterator *(*filter)(struct Iterator *iterator, bool (*predicateFn)(void *element));
+
+  /**
+   * \brief Transforms each element with the given function.
+   * \param iterator This iterator, now owned by the returned iterator.
+   * \param mapFn Returns the transformed element.
+   * \return The new chained iterator.
+   */
+  struct Iterator *(*map)(struct Iterator *iterator, void *(*mapFn)(void *element));
+
+  /**
+   * \brief Stops after the given number of elements.
+   * \param iterator This iterator, now owned by the returned iterator.
+   * \param count The maximum number of elements to return.
+   * \return The new chained iterator.
+   */
+  struct Iterator *(*take)(struct Iterator *iterator, size_t count);
+
+  /**
+   * \brief Skips the given number of elements.
+   * \param iterator This iterator, now owned by the returned iterator.
+   * \param count The number of elements to skip.
+   * \return The new chained iterator.
+   */
+  struct Iterator *(*skip)(struct Iterator *iterator, size_t count);
+
+  /**
+   * \brief Appends all the remaining elements to an array.
+   *
+   * The array is reserved up front for the lower bound of the size hint so
+   * an iterator of known size (e.g. a map over an array) reallocates it at
+   * most once.
+   *
+   * \param iterator This iterator.
+   * \param array The array to append the elements to.
+   */
+  void (*collectIntoArray)(struct Iterator *iterator, Array *array);
+
+  /**
+   * \brief Appends all the remaining elements to a linked list.
+   * \param iterator This iterator.
+   * \param list The list to append the elements to.
+   */
+  void (*collectIntoLinkedList)(struct Iterator *iterator, LinkedList *list);
+
+  /**
+   * \brief Folds all the remaining elements into a single value.
+   * \param iterator This iterator.
+   * \param accumulator The initial value.
+   * \param reduceFn Returns the new accumulator given the current one and the
+   *                 next element.
+   * \return The final accumulator.
+   */
+  void *(*reduce)(struct Iterator *iterator, void *accumulator, void *(*reduceFn)(void *accumulator, void *element));
+
+  /**
+   * \brief Frees the iterator and all the iterators it's chained to.
+   *
+   * The collection and its elements are left untouched.
+   *
+   * \param iterator This iterator.
+   */
+  void (*destroy)(struct Iterator *iterator);
+} Iterator;
+
+/**
+ * \brief Creates an iterator over the elements of an array.
+ * \param array The array to iterate.
+ * \return The new iterator.
+ */
+Iterator *createArrayIterator(Array *array);
+
+/**
+ * \brief Creates an iterator over the elements of a linked list.
+ * \param list The list to iterate.
+ * \return The new iterator.
+ */
+Iterator *createLinkedListIterator(LinkedList *list);
+
+#endif // COLLECTIONS_ITERATOR_H
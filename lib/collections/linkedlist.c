@@ -1,9 +1,14 @@
 #include "linkedlist.h"
+#include "iterator.h"
+#include "stringbuilder.h"
 #include <stdlib.h>
 #include <string.h>
 
-LinkedNode *createLinkedNode(void *value);
-void *destroyLinkedNode(LinkedNode *node);
+LinkedNode *createLinkedNode(Arena *arena, void *value);
+void *destroyLinkedNode(Arena *arena, LinkedNode *node);
+LinkedNode *splitLinkedNodes(LinkedNode *node, size_t count);
+LinkedNode **mergeLinkedNodes(LinkedNode **link, LinkedNode *left, LinkedNode *right, int (*compareFn)(void *a, void *b));
+void *removeLinkedElement(LinkedList *list, void *element, size_t *scanned);
 
 void append_LinkedList(LinkedList *list, void *element);
 void prepend_LinkedList(LinkedList *list, void *element);
@@ -15,14 +20,24 @@ void *remove_LinkedList(LinkedList *list, void *element);
 void *removeAt_LinkedList(LinkedList *list, size_t index);
 void removeAll_LinkedList(LinkedList *list, void (*destroyElementFn)(void *element));
 char *toString_LinkedList(LinkedList *list, char *(*stringifyFn)(void *element));
+void appendTo_LinkedList(LinkedList *list, StringBuilder *builder,
+                         void (*appendElementFn)(StringBuilder *builder, void *element));
+void sort_LinkedList(LinkedList *list, int (*compareFn)(void *a, void *b));
 void destroy_LinkedList(LinkedList *list, void (*destroyElementFn)(void *element));
 
 LinkedList *createLinkedList()
 {
-  LinkedList *list = malloc(sizeof(LinkedList));
+  return createLinkedListIn(NULL);
+}
+
+LinkedList *createLinkedListIn(Arena *arena)
+{
+  LinkedList *list = allocIn(arena, sizeof(LinkedList));
+  list->arena = arena;
   list->head = NULL;
   list->tail = NULL;
   list->size = 0;
+  STATS_RESET(list);
 
   list->append = append_LinkedList;
   list->prepend = prepend_LinkedList;
@@ -34,23 +49,26 @@ LinkedList *createLinkedList()
   list->removeAt = removeAt_LinkedList;
   list->removeAll = removeAll_LinkedList;
   list->toString = toString_LinkedList;
+  list->appendTo = appendTo_LinkedList;
+  list->sort = sort_LinkedList;
+  list->iterator = createLinkedListIterator;
   list->destroy = destroy_LinkedList;
   return list;
 }
 
-LinkedNode *createLinkedNode(void *value)
+LinkedNode *createLinkedNode(Arena *arena, void *value)
 {
-  LinkedNode *node = malloc(sizeof(LinkedNode));
+  LinkedNode *node = allocIn(arena, sizeof(LinkedNode));
   node->value = value;
   node->next = NULL;
   node->prev = NULL;
   return node;
 }
 
-void *destroyLinkedNode(LinkedNode *node)
+void *destroyLinkedNode(Arena *arena, LinkedNode *node)
 {
   void *element = node->value;
-  free(node);
+  freeIn(arena, node);
   return element;
 }
 
@@ -63,7 +81,9 @@ void append_LinkedList(LinkedList *list, void *element)
     return;
   }
 
-  LinkedNode *node = createLinkedNode(element);
+  LinkedNode *node = createLinkedNode(list->arena, element);
+  STATS_ADD(list, allocations, 1);
+  STATS_ADD(list, adds, 1);
 
   // Case: has one element
   if (list->size == 1 && list->head == list->tail)
@@ -85,7 +105,9 @@ void append_LinkedList(LinkedList *list, void *element)
 
 void prepend_LinkedList(LinkedList *list, void *element)
 {
-  LinkedNode *node = createLinkedNode(element);
+  LinkedNode *node = createLinkedNode(list->arena, element);
+  STATS_ADD(list, allocations, 1);
+  STATS_ADD(list, adds, 1);
 
   // Case: no elements
   if (list->head == NULL && list->tail == NULL && list->size == 0)
@@ -137,10 +159,14 @@ void insertAt_LinkedList(LinkedList *list, void *element, size_t size)
   }
 
   // Case: has two or more elements
-  LinkedNode *node = createLinkedNode(element);
+  LinkedNode *node = createLinkedNode(list->arena, element);
   LinkedNode *current = list->head;
-  for (size_t i = 0; current->next != NULL && i != size; i++)
+  size_t i = 0;
+  for (; current->next != NULL && i != size; i++)
     current = current->next;
+  STATS_ADD(list, allocations, 1);
+  STATS_ADD(list, inserts, 1);
+  STATS_SCAN(list, i);
   node->prev = current->prev;
   node->next = current;
   current->prev = node;
@@ -150,10 +176,17 @@ void insertAt_LinkedList(LinkedList *list, void *element, size_t size)
 
 size_t indexOf_LinkedList(LinkedList *list, void *element)
 {
+  STATS_ADD(list, lookups, 1);
   size_t index = 0;
   for (LinkedNode *current = list->head; current != NULL; current = current->next, index++)
+  {
     if (current->value == element)
+    {
+      STATS_SCAN(list, index + 1);
       return index;
+    }
+  }
+  STATS_SCAN(list, index);
   return -1;
 }
 
@@ -164,13 +197,14 @@ void *removeBeg_LinkedList(LinkedList *list)
 
   // unchain head
   LinkedNode *nextHead = list->head->next;
-  void *removedElement = destroyLinkedNode(list->head);
+  void *removedElement = destroyLinkedNode(list->arena, list->head);
   list->head = nextHead;
   if (nextHead != NULL)
     nextHead->prev = NULL;
   else
     list->tail = NULL;
   list->size--;
+  STATS_ADD(list, removes, 1);
 
   return removedElement;
 }
@@ -182,24 +216,37 @@ void *removeEnd_LinkedList(LinkedList *list)
 
   // unchain tail
   LinkedNode *nextTail = list->tail->prev;
-  void *removedElement = destroyLinkedNode(list->tail);
+  void *removedElement = destroyLinkedNode(list->arena, list->tail);
   list->tail = nextTail;
   if (nextTail != NULL)
     nextTail->next = NULL;
   else
     list->head = NULL;
   list->size--;
+  STATS_ADD(list, removes, 1);
 
   return removedElement;
 }
 
 void *remove_LinkedList(LinkedList *list, void *element)
 {
+  size_t scanned;
+  void *removedElement = removeLinkedElement(list, element, &scanned);
+  STATS_SCAN(list, scanned);
+  return removedElement;
+}
+
+void *removeLinkedElement(LinkedList *list, void *element, size_t *scanned)
+{
+  // the number of nodes looked at is given back so each public call records a single scan
+  *scanned = 0;
+
   // Case: no elements
   if (list->head == NULL && list->tail == NULL && list->size == 0)
     return NULL;
 
   // Case: element to remove is in the head or tail
+  *scanned = 1;
   if (list->head->value == element)
     return removeBeg_LinkedList(list);
   if (list->tail->value == element)
@@ -207,19 +254,22 @@ void *remove_LinkedList(LinkedList *list, void *element)
 
   // Case: element is in the middle
   void *removedElement = NULL;
+  *scanned = 0;
   for (LinkedNode *current = list->head; current != NULL; current = current->next)
   {
+    (*scanned)++;
     if (current->value != element)
       continue;
 
     LinkedNode *preCurrent = current->prev;
     LinkedNode *postCurrent = current->next;
-    removedElement = destroyLinkedNode(current);
+    removedElement = destroyLinkedNode(list->arena, current);
     if (preCurrent != NULL)
       preCurrent->next = postCurrent;
     if (postCurrent != NULL)
       postCurrent->prev = preCurrent;
     list->size--;
+    STATS_ADD(list, removes, 1);
     break;
   }
 
@@ -240,7 +290,11 @@ void *removeAt_LinkedList(LinkedList *list, size_t indexToRemove)
     if (index == indexToRemove)
       elementToRemove = current->value;
 
-  return remove_LinkedList(list, elementToRemove);
+  // a single scan for the whole call, finding the element then its node
+  size_t scanned;
+  void *removedElement = removeLinkedElement(list, elementToRemove, &scanned);
+  STATS_SCAN(list, index + scanned);
+  return removedElement;
 }
 
 void removeAll_LinkedList(LinkedList *list, void (*destroyElementFn)(void *element))
@@ -260,40 +314,121 @@ char *toString_LinkedList(LinkedList *list, char *(*stringifyFn)(void *element))
   if (stringifyFn == NULL)
     return NULL;
 
-  // '[', ']', '\0' plus ", " for each element exluding the last element
-  size_t length = 1 + 1 + 1 + 2 * (list->size - 1);
+  // build the string as we go and free each element's string right away
+  StringBuilder *builder = createStringBuilder();
+  builder->appendChar(builder, '[');
+  for (LinkedNode *current = list->head; current != NULL; current = current->next)
+  {
+    char *elementString = stringifyFn(current->value);
+    if (elementString != NULL)
+    {
+      builder->append(builder, elementString);
+      free(elementString);
+    }
 
-  // extract each stringified version of the elements
-  LinkedList *elementStrings = createLinkedList();
+    if (current->next != NULL)
+      builder->append(builder, ", ");
+  }
+  builder->appendChar(builder, ']');
+
+  char *stringified = builder->toString(builder);
+  builder->destroy(builder);
+  return stringified;
+}
+
+void appendTo_LinkedList(LinkedList *list, StringBuilder *builder,
+                         void (*appendElementFn)(StringBuilder *builder, void *element))
+{
+  builder->appendChar(builder, '[');
   for (LinkedNode *current = list->head; current != NULL; current = current->next)
   {
-    elementStrings->append(elementStrings, stringifyFn(current->value));
-    if (elementStrings->tail->value != NULL)
-      length += strlen(elementStrings->tail->value);
+    appendElementFn(builder, current->value);
+    if (current->next != NULL)
+      builder->append(builder, ", ");
+  }
+  builder->appendChar(builder, ']');
+}
+
+LinkedNode *splitLinkedNodes(LinkedNode *node, size_t count)
+{
+  // cut the chain after count nodes and return the rest of it
+  for (size_t i = 1; node != NULL && i < count; i++)
+    node = node->next;
+  if (node == NULL)
+    return NULL;
+
+  LinkedNode *rest = node->next;
+  node->next = NULL;
+  return rest;
+}
+
+LinkedNode **mergeLinkedNodes(LinkedNode **link, LinkedNode *left, LinkedNode *right, int (*compareFn)(void *a, void *b))
+{
+  // taking from the left on ties keeps the sort stable
+  while (left != NULL && right != NULL)
+  {
+    if (compareFn(left->value, right->value) <= 0)
+    {
+      *link = left;
+      left = left->next;
+    }
+    else
+    {
+      *link = right;
+      right = right->next;
+    }
+    link = &(*link)->next;
   }
 
-  // build string list and also free the elements' strings
-  char *stringified = malloc(length);
-  strcpy(stringified, "[");
-  for (LinkedNode *current = elementStrings->head; current != NULL; current = current->next)
+  *link = left != NULL ? left : right;
+  while (*link != NULL)
+    link = &(*link)->next;
+  return link;
+}
+
+void sort_LinkedList(LinkedList *list, int (*compareFn)(void *a, void *b))
+{
+  if (list->size < 2)
+    return;
+
+  // merge runs of width 1, 2, 4, ... only following the next pointers
+  LinkedNode *head = list->head;
+  for (size_t width = 1; width < list->size; width *= 2)
   {
-    if (current->value != NULL)
+    LinkedNode *remaining = head;
+    LinkedNode **link = &head;
+    while (remaining != NULL)
     {
-      strcat(stringified, current->value);
-      free(current->value);
+      LinkedNode *left = remaining;
+      LinkedNode *right = splitLinkedNodes(left, width);
+      remaining = splitLinkedNodes(right, width);
+      link = mergeLinkedNodes(link, left, right, compareFn);
     }
+  }
 
+  // then chain back the prev pointers
+  list->head = head;
+  head->prev = NULL;
+  for (LinkedNode *current = head; current != NULL; current = current->next)
+  {
     if (current->next != NULL)
-      strcat(stringified, ", ");
+      current->next->prev = current;
+    else
+      list->tail = current;
   }
-  strcat(stringified, "]");
-  free(elementStrings); // TODO: use the destroy function when it's done
-
-  return stringified;
 }
 
 void destroy_LinkedList(LinkedList *list, void (*destroyElementFn)(void *element))
 {
-  removeAll_LinkedList(list, destroyElementFn);
-  free(list);
+  // no need to unchain each node one by one since they're all going away
+  LinkedNode *current = list->head;
+  while (current != NULL)
+  {
+    LinkedNode *next = current->next;
+    void *element = destroyLinkedNode(list->arena, current);
+    if (destroyElementFn != NULL)
+      destroyElementFn(element);
+    current = next;
+  }
+  freeIn(list->arena, list);
 }
@@ -2,6 +2,11 @@
 #define LINKEDLIST_H
 
 #include <stddef.h>
+#include "stats.h"
+#include "arena.h"
+
+struct Iterator;
+struct StringBuilder;
 
 /**
  * \struct LinkedNode
@@ -20,10 +25,15 @@ typedef struct LinkedNode
  */
 typedef struct LinkedList
 {
+  Arena *arena;     /**< The arena the list allocates its nodes from, NULL for the heap. */
   LinkedNode *head; /**< Pointer to the head (first node) of the linked list. */
   LinkedNode *tail; /**< Pointer to the tail (last node) of the linked list. */
   size_t size;      /**< Number of elements in the linked list. */
 
+#ifdef COLLECTIONS_STATS
+  CollectionStats stats; /**< Counters of the operations done on the linked list. */
+#endif
+
   /**
    * \brief Appends an element to the end of the linked list.
    * \param list This list.
@@ -116,6 +126,40 @@ typedef struct LinkedList
    */
   char *(*toString)(struct LinkedList *list, char *(*stringifyFn)(void *element));
 
+  /**
+   * \brief Stringifies the linked list into a string builder.
+   *
+   * Unlike toString, the appendElementFn writes each element straight into
+   * the builder so nothing is allocated for each element.
+   *
+   * \param list This list.
+   * \param builder The string builder to append to.
+   * \param appendElementFn A function appending the string version of an
+   *                        element to the builder.
+   */
+  void (*appendTo)(struct LinkedList *list, struct StringBuilder *builder,
+                   void (*appendElementFn)(struct StringBuilder *builder, void *element));
+
+  /**
+   * \brief Sorts the linked list in ascending order.
+   *
+   * Uses a bottom-up merge sort which relinks the nodes in place, nothing is
+   * allocated. The sort is stable.
+   *
+   * \param list This list.
+   * \param compareFn Returns a negative number if a comes before b, a positive
+   *                  number if it comes after and 0 if they are equal.
+   */
+  void (*sort)(struct LinkedList *list, int (*compareFn)(void *a, void *b));
+
+  /**
+   * \brief Creates a lazy iterator over the elements of the linked list.
+   * \param list This list.
+   * \return The new iterator.
+   * \warning It is up to the caller to destroy the iterator.
+   */
+  struct Iterator *(*iterator)(struct LinkedList *list);
+
   /**
    * \brief Destroys the linked list, freeing all resources, and optionally
    *        destroying each element (which must be mandatory to avoid memory
@@ -134,4 +178,16 @@ typedef struct LinkedList
  */
 LinkedList *createLinkedList();
 
+/**
+ * \brief Creates and returns a new empty linked list allocated from an arena.
+ *
+ * The list and all of its nodes are allocated from the arena so they are all
+ * released at once when the arena is reset, there's no need to destroy the
+ * list (unless its elements must be destroyed).
+ *
+ * \param arena The arena to allocate from, if NULL the heap is used.
+ * \return A pointer to the created linked list.
+ */
+LinkedList *createLinkedListIn(Arena *arena);
+
 #endif // LINKEDLIST_H
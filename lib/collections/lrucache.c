@@ -0,0 +1,204 @@
+#include "lrucache.h"
+#include <stdlib.h>
+
+LruEntry **findLruEntry(LruCache *cache, void *key, size_t hash);
+LruEntry **linkLruEntry(LruCache *cache, LruEntry *entry);
+void unchainLruEntry(LruCache *cache, LruEntry *entry);
+void chainLruEntry(LruCache *cache, LruEntry *entry);
+void evictLruEntry(LruCache *cache, LruEntry **link);
+
+void *get_LruCache(LruCache *cache, void *key);
+void *put_LruCache(LruCache *cache, void *key, void *value);
+bool touch_LruCache(LruCache *cache, void *key);
+bool remove_LruCache(LruCache *cache, void *key);
+void removeAll_LruCache(LruCache *cache);
+void destroy_LruCache(LruCache *cache, void (*destroyEntryFn)(void *key, void *value));
+
+LruCache *createLruCache(size_t capacity, size_t (*hashFn)(void *key), bool (*equalsFn)(void *a, void *b),
+                         void (*evictEntryFn)(void *key, void *value))
+{
+  LruCache *cache = malloc(sizeof(LruCache));
+  cache->head = NULL;
+  cache->tail = NULL;
+  cache->capacity = capacity;
+  cache->size = 0;
+  cache->hits = 0;
+  cache->misses = 0;
+  cache->hashFn = hashFn;
+  cache->equalsFn = equalsFn;
+  cache->evictEntryFn = evictEntryFn;
+
+  // keep the load factor under 3/4 so the buckets stay short
+  cache->bucketCount = 1;
+  while (cache->bucketCount * 3 < capacity * 4)
+    cache->bucketCount *= 2;
+  cache->buckets = calloc(cache->bucketCount, sizeof(LruEntry *));
+
+  // chain all the entries as unused
+  cache->entries = malloc(sizeof(LruEntry) * (capacity != 0 ? capacity : 1));
+  cache->unused = NULL;
+  for (size_t i = 0; i < capacity; i++)
+  {
+    cache->entries[i].next = cache->unused;
+    cache->unused = &cache->entries[i];
+  }
+
+  cache->get = get_LruCache;
+  cache->put = put_LruCache;
+  cache->touch = touch_LruCache;
+  cache->remove = remove_LruCache;
+  cache->removeAll = removeAll_LruCache;
+  cache->destroy = destroy_LruCache;
+  return cache;
+}
+
+LruEntry **findLruEntry(LruCache *cache, void *key, size_t hash)
+{
+  // return the link pointing to the entry so it can be unlinked from its bucket
+  LruEntry **link = &cache->buckets[hash & (cache->bucketCount - 1)];
+  for (; *link != NULL; link = &(*link)->bucket)
+    if ((*link)->hash == hash && cache->equalsFn((*link)->key, key))
+      return link;
+  return link;
+}
+
+LruEntry **linkLruEntry(LruCache *cache, LruEntry *entry)
+{
+  // same as findLruEntry but compares the entries themselves, not the keys
+  LruEntry **link = &cache->buckets[entry->hash & (cache->bucketCount - 1)];
+  while (*link != entry)
+    link = &(*link)->bucket;
+  return link;
+}
+
+void unchainLruEntry(LruCache *cache, LruEntry *entry)
+{
+  if (entry->prev != NULL)
+    entry->prev->next = entry->next;
+  else
+    cache->head = entry->next;
+
+  if (entry->next != NULL)
+    entry->next->prev = entry->prev;
+  else
+    cache->tail = entry->prev;
+}
+
+void chainLruEntry(LruCache *cache, LruEntry *entry)
+{
+  // as the most recently used
+  entry->prev = NULL;
+  entry->next = cache->head;
+  if (cache->head != NULL)
+    cache->head->prev = entry;
+  else
+    cache->tail = entry;
+  cache->head = entry;
+}
+
+void evictLruEntry(LruCache *cache, LruEntry **link)
+{
+  LruEntry *entry = *link;
+  *link = entry->bucket;
+  unchainLruEntry(cache, entry);
+  cache->size--;
+
+  if (cache->evictEntryFn != NULL)
+    cache->evictEntryFn(entry->key, entry->value);
+
+  entry->next = cache->unused;
+  cache->unused = entry;
+}
+
+void *get_LruCache(LruCache *cache, void *key)
+{
+  LruEntry *entry = *findLruEntry(cache, key, cache->hashFn(key));
+  if (entry == NULL)
+  {
+    cache->misses++;
+    return NULL;
+  }
+
+  cache->hits++;
+  unchainLruEntry(cache, entry);
+  chainLruEntry(cache, entry);
+  return entry->value;
+}
+
+void *put_LruCache(LruCache *cache, void *key, void *value)
+{
+  // Case: no room at all
+  if (cache->capacity == 0)
+  {
+    if (cache->evictEntryFn != NULL)
+      cache->evictEntryFn(key, value);
+    return NULL;
+  }
+
+  // Case: key already in the cache, only swap its value so its key stays valid
+  size_t hash = cache->hashFn(key);
+  LruEntry *entry = *findLruEntry(cache, key, hash);
+  if (entry != NULL)
+  {
+    void *replaced = entry->value;
+    entry->value = value;
+    unchainLruEntry(cache, entry);
+    chainLruEntry(cache, entry);
+    return replaced;
+  }
+
+  // Case: cache is full, make room for it
+  if (cache->size == cache->capacity)
+    evictLruEntry(cache, linkLruEntry(cache, cache->tail));
+
+  entry = cache->unused;
+  cache->unused = entry->next;
+  entry->key = key;
+  entry->value = value;
+  entry->hash = hash;
+
+  LruEntry **bucket = &cache->buckets[hash & (cache->bucketCount - 1)];
+  entry->bucket = *bucket;
+  *bucket = entry;
+  chainLruEntry(cache, entry);
+  cache->size++;
+  return NULL;
+}
+
+bool touch_LruCache(LruCache *cache, void *key)
+{
+  LruEntry *entry = *findLruEntry(cache, key, cache->hashFn(key));
+  if (entry == NULL)
+    return false;
+
+  unchainLruEntry(cache, entry);
+  chainLruEntry(cache, entry);
+  return true;
+}
+
+bool remove_LruCache(LruCache *cache, void *key)
+{
+  LruEntry **link = findLruEntry(cache, key, cache->hashFn(key));
+  if (*link == NULL)
+    return false;
+
+  evictLruEntry(cache, link);
+  return true;
+}
+
+void removeAll_LruCache(LruCache *cache)
+{
+  while (cache->tail != NULL)
+    evictLruEntry(cache, linkLruEntry(cache, cache->tail));
+}
+
+void destroy_LruCache(LruCache *cache, void (*destroyEntryFn)(void *key, void *value))
+{
+  if (destroyEntryFn != NULL)
+    for (LruEntry *entry = cache->head; entry != NULL; entry = entry->next)
+      destroyEntryFn(entry->key, entry->value);
+
+  free(cache->buckets);
+  free(cache->entries);
+  free(cache);
+}
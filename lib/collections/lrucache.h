@@ -0,0 +1,118 @@
+#ifndef COLLECTIONS_LRUCACHE_H
+#define COLLECTIONS_LRUCACHE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * \struct LruEntry
+ * \brief A key-value pair stored in an LruCache.
+ */
+typedef struct LruEntry
+{
+  void *key;               /**< Pointer to the key of the entry. */
+  void *value;             /**< Pointer to the value of the entry. */
+  size_t hash;             /**< The hash of the key. */
+  struct LruEntry *next;   /**< Pointer to the next less recently used entry. */
+  struct LruEntry *prev;   /**< Pointer to the next more recently used entry. */
+  struct LruEntry *bucket; /**< Pointer to the next entry in the same bucket. */
+} LruEntry;
+
+/**
+ * \struct LruCache
+ * \brief A bounded cache evicting its least recently used entry when full.
+ *
+ * The entries are indexed by a hash table and kept in a doubly linked list
+ * ordered by use, so getting, putting and touching an entry are all O(1). All
+ * the entries are allocated up front, nothing is allocated afterwards.
+ */
+typedef struct LruCache
+{
+  LruEntry *head;     /**< Pointer to the most recently used entry. */
+  LruEntry *tail;     /**< Pointer to the least recently used entry. */
+  LruEntry **buckets; /**< The hash table of the entries. */
+  size_t bucketCount; /**< Number of buckets of the hash table (a power of 2). */
+  LruEntry *entries;  /**< All the entries, allocated up front. */
+  LruEntry *unused;   /**< Pointer to the first unused entry. */
+  size_t capacity;    /**< Maximum number of entries in the cache. */
+  size_t size;        /**< Number of entries in the cache. */
+  size_t hits;        /**< Number of times get found the key. */
+  size_t misses;      /**< Number of times get did not find the key. */
+
+  size_t (*hashFn)(void *key);                  /**< Returns the hash of a key. */
+  bool (*equalsFn)(void *a, void *b);           /**< Returns true if two keys are equal. */
+  void (*evictEntryFn)(void *key, void *value); /**< Called with each entry leaving the cache, can be NULL. */
+
+  /**
+   * \brief Returns the value of a key and marks it as the most recently used.
+   * \param cache This cache.
+   * \param key The key to find.
+   * \return The value of the key, or NULL if the key is not in the cache.
+   */
+  void *(*get)(struct LruCache *cache, void *key);
+
+  /**
+   * \brief Puts a key-value pair in the cache as the most recently used.
+   *
+   * If the key is already in the cache, only its value is replaced and the
+   * entry is kept with the key it was first put with. Otherwise, if the cache
+   * is full, the least recently used entry is evicted first.
+   *
+   * \param cache This cache.
+   * \param key The key of the entry.
+   * \param value The value of the entry.
+   * \return The replaced value, or NULL if the key wasn't in the cache.
+   * \warning It is up to the caller to free the replaced value, and the given
+   *          key if it's not the one in the cache.
+   */
+  void *(*put)(struct LruCache *cache, void *key, void *value);
+
+  /**
+   * \brief Marks a key as the most recently used without counting a hit.
+   * \param cache This cache.
+   * \param key The key to touch.
+   * \return true if the key is in the cache, otherwise false.
+   */
+  bool (*touch)(struct LruCache *cache, void *key);
+
+  /**
+   * \brief Evicts a key from the cache.
+   * \param cache This cache.
+   * \param key The key to evict.
+   * \return true if the key was in the cache, otherwise false.
+   */
+  bool (*remove)(struct LruCache *cache, void *key);
+
+  /**
+   * \brief Evicts all the entries from the cache.
+   * \param cache This cache.
+   */
+  void (*removeAll)(struct LruCache *cache);
+
+  /**
+   * \brief Frees the cache from memory.
+   *
+   * The entries still in the cache are NOT evicted, they are passed to
+   * destroyEntryFn instead.
+   *
+   * \param cache This cache.
+   * \param destroyEntryFn The function used to free each key-value pair.
+   * \warning destroyEntryFn is mandatory to avoid memory leaks, however,
+   *          it can be NULL.
+   */
+  void (*destroy)(struct LruCache *cache, void (*destroyEntryFn)(void *key, void *value));
+} LruCache;
+
+/**
+ * \brief Creates a new empty LRU cache.
+ * \param capacity The maximum number of entries in the cache.
+ * \param hashFn Returns the hash of a key.
+ * \param equalsFn Returns true if two keys are equal.
+ * \param evictEntryFn Called with each key-value pair evicted from the cache
+ *                     (e.g. to free them), can be NULL.
+ * \return The new LRU cache.
+ */
+LruCache *createLruCache(size_t capacity, size_t (*hashFn)(void *key), bool (*equalsFn)(void *a, void *b),
+                         void (*evictEntryFn)(void *key, void *value));
+
+#endif // COLLECTIONS_LRUCACHE_H
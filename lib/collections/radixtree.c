@@ -0,0 +1,824 @@
+#include "radixtree.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+// the leaves are told apart from the nodes by the lowest bit of their pointer
+#define IS_RADIX_LEAF(child) (((uintptr_t)(child)) & 1)
+#define TAG_RADIX_LEAF(leaf) ((void *)((uintptr_t)(leaf) | 1))
+#define UNTAG_RADIX_LEAF(child) ((RadixLeaf *)((uintptr_t)(child) & ~(uintptr_t)1))
+
+#define MIN_RADIX(a, b) ((a) < (b) ? (a) : (b))
+
+RadixLeaf *createRadixLeaf(const unsigned char *key, size_t keyLength, void *value);
+bool matchesRadixLeaf(RadixLeaf *leaf, const unsigned char *key, size_t keyLength);
+RadixNode *createRadixNode(RadixNodeType type);
+void replaceRadixNode(void **ref, RadixNode *node, RadixNode *replacement);
+RadixLeaf *minimumRadixLeaf(void *child);
+size_t matchRadixPrefix(RadixNode *node, const unsigned char *key, size_t keyLength, size_t depth);
+void **findRadixChild(RadixNode *node, unsigned char byte);
+void insertSortedRadixChild(unsigned char *keys, void **children, size_t count, unsigned char byte, void *child);
+void addRadixChild(void **ref, RadixNode *node, unsigned char byte, void *child);
+void addRadixLeaf(void **ref, RadixLeaf *leaf, size_t depth);
+void removeRadixChild(RadixNode *node, unsigned char byte);
+void shrinkRadixNode(void **ref);
+void *insertRadixNode(RadixTree *tree, void **ref, const unsigned char *key, size_t keyLength, void *value,
+                      size_t depth);
+RadixLeaf *removeRadixNode(void **ref, const unsigned char *key, size_t keyLength, size_t depth);
+void *findRadixPrefix(RadixTree *tree, const unsigned char *prefix, size_t prefixLength);
+void visitRadixNode(void *child, void (*visitFn)(const unsigned char *key, size_t keyLength, void *value),
+                    Array *values);
+void destroyRadixNode(void *child, void (*destroyElementFn)(void *element));
+void encodeRadixInteger(uint64_t key, unsigned char *bytes);
+
+void *insert_RadixTree(RadixTree *tree, const void *key, size_t keyLength, void *value);
+void *search_RadixTree(RadixTree *tree, const void *key, size_t keyLength);
+void *remove_RadixTree(RadixTree *tree, const void *key, size_t keyLength);
+void *insertInteger_RadixTree(RadixTree *tree, uint64_t key, void *value);
+void *searchInteger_RadixTree(RadixTree *tree, uint64_t key);
+void *removeInteger_RadixTree(RadixTree *tree, uint64_t key);
+Array *prefixScan_RadixTree(RadixTree *tree, const void *prefix, size_t prefixLength);
+void forEachPrefix_RadixTree(RadixTree *tree, const void *prefix, size_t prefixLength,
+                             void (*visitFn)(const unsigned char *key, size_t keyLength, void *value));
+void forEach_RadixTree(RadixTree *tree, void (*visitFn)(const unsigned char *key, size_t keyLength, void *value));
+void destroy_RadixTree(RadixTree *tree, void (*destroyElementFn)(void *element));
+
+RadixTree *createRadixTree()
+{
+  RadixTree *tree = malloc(sizeof(RadixTree));
+  tree->root = NULL;
+  tree->size = 0;
+
+  tree->insert = insert_RadixTree;
+  tree->search = search_RadixTree;
+  tree->remove = remove_RadixTree;
+  tree->insertInteger = insertInteger_RadixTree;
+  tree->searchInteger = searchInteger_RadixTree;
+  tree->removeInteger = removeInteger_RadixTree;
+  tree->prefixScan = prefixScan_RadixTree;
+  tree->forEachPrefix = forEachPrefix_RadixTree;
+  tree->forEach = forEach_RadixTree;
+  tree->destroy = destroy_RadixTree;
+  return tree;
+}
+
+RadixLeaf *createRadixLeaf(const unsigned char *key, size_t keyLength, void *value)
+{
+  RadixLeaf *leaf = malloc(sizeof(RadixLeaf) + keyLength);
+  leaf->value = value;
+  leaf->keyLength = keyLength;
+  if (keyLength != 0)
+    memcpy(leaf->key, key, keyLength);
+  return leaf;
+}
+
+bool matchesRadixLeaf(RadixLeaf *leaf, const unsigned char *key, size_t keyLength)
+{
+  return leaf->keyLength == keyLength && (keyLength == 0 || memcmp(leaf->key, key, keyLength) == 0);
+}
+
+RadixNode *createRadixNode(RadixNodeType type)
+{
+  RadixNode *node;
+  switch (type)
+  {
+  case RADIX_NODE_4:
+    node = calloc(1, sizeof(RadixNode4));
+    break;
+  case RADIX_NODE_16:
+    node = calloc(1, sizeof(RadixNode16));
+    break;
+  case RADIX_NODE_48:
+    node = calloc(1, sizeof(RadixNode48));
+    break;
+  default:
+    node = calloc(1, sizeof(RadixNode256));
+    break;
+  }
+  node->type = type;
+  return node;
+}
+
+void replaceRadixNode(void **ref, RadixNode *node, RadixNode *replacement)
+{
+  // the children must already be copied, only the header is left
+  replacement->childCount = node->childCount;
+  replacement->prefixLength = node->prefixLength;
+  memcpy(replacement->prefix, node->prefix, RADIX_TREE_MAX_PREFIX);
+  replacement->leaf = node->leaf;
+  free(node);
+  *ref = replacement;
+}
+
+RadixLeaf *minimumRadixLeaf(void *child)
+{
+  // a key ending at a node is shorter, hence smaller, than all its children's
+  while (!IS_RADIX_LEAF(child))
+  {
+    RadixNode *node = child;
+    if (node->leaf != NULL)
+      return node->leaf;
+
+    switch (node->type)
+    {
+    case RADIX_NODE_4:
+      child = ((RadixNode4 *)node)->children[0];
+      break;
+
+    case RADIX_NODE_16:
+      child = ((RadixNode16 *)node)->children[0];
+      break;
+
+    case RADIX_NODE_48:
+    {
+      RadixNode48 *node48 = (RadixNode48 *)node;
+      size_t i = 0;
+      while (node48->childIndex[i] == 0)
+        i++;
+      child = node48->children[node48->childIndex[i] - 1];
+      break;
+    }
+
+    case RADIX_NODE_256:
+    {
+      RadixNode256 *node256 = (RadixNode256 *)node;
+      size_t i = 0;
+      while (node256->children[i] == NULL)
+        i++;
+      child = node256->children[i];
+      break;
+    }
+    }
+  }
+  return UNTAG_RADIX_LEAF(child);
+}
+
+size_t matchRadixPrefix(RadixNode *node, const unsigned char *key, size_t keyLength, size_t depth)
+{
+  // returns how many bytes of the node's prefix match the key, bounded by the key's length
+  size_t limit = MIN_RADIX(node->prefixLength, keyLength - depth);
+  size_t stored = MIN_RADIX(limit, RADIX_TREE_MAX_PREFIX);
+
+  size_t i = 0;
+  for (; i < stored; i++)
+    if (node->prefix[i] != key[depth + i])
+      return i;
+
+  // only the first bytes of long prefixes are stored, any leaf below has the rest
+  if (i < limit)
+  {
+    RadixLeaf *leaf = minimumRadixLeaf(node);
+    for (; i < limit; i++)
+      if (leaf->key[depth + i] != key[depth + i])
+        return i;
+  }
+  return i;
+}
+
+void **findRadixChild(RadixNode *node, unsigned char byte)
+{
+  switch (node->type)
+  {
+  case RADIX_NODE_4:
+  {
+    RadixNode4 *node4 = (RadixNode4 *)node;
+    for (size_t i = 0; i < node->childCount; i++)
+      if (node4->keys[i] == byte)
+        return &node4->children[i];
+    return NULL;
+  }
+
+  case RADIX_NODE_16:
+  {
+    // the keys are sorted so give up as soon as they're past the byte
+    RadixNode16 *node16 = (RadixNode16 *)node;
+    for (size_t i = 0; i < node->childCount && node16->keys[i] <= byte; i++)
+      if (node16->keys[i] == byte)
+        return &node16->children[i];
+    return NULL;
+  }
+
+  case RADIX_NODE_48:
+  {
+    RadixNode48 *node48 = (RadixNode48 *)node;
+    if (node48->childIndex[byte] == 0)
+      return NULL;
+    return &node48->children[node48->childIndex[byte] - 1];
+  }
+
+  case RADIX_NODE_256:
+  {
+    RadixNode256 *node256 = (RadixNode256 *)node;
+    return node256->children[byte] != NULL ? &node256->children[byte] : NULL;
+  }
+  }
+  return NULL;
+}
+
+void insertSortedRadixChild(unsigned char *keys, void **children, size_t count, unsigned char byte, void *child)
+{
+  size_t i = count;
+  for (; i > 0 && keys[i - 1] > byte; i--)
+  {
+    keys[i] = keys[i - 1];
+    children[i] = children[i - 1];
+  }
+  keys[i] = byte;
+  children[i] = child;
+}
+
+void addRadixChild(void **ref, RadixNode *node, unsigned char byte, void *child)
+{
+  switch (node->type)
+  {
+  case RADIX_NODE_4:
+  {
+    RadixNode4 *node4 = (RadixNode4 *)node;
+    if (node->childCount < 4)
+    {
+      insertSortedRadixChild(node4->keys, node4->children, node->childCount++, byte, child);
+      return;
+    }
+
+    RadixNode16 *node16 = (RadixNode16 *)createRadixNode(RADIX_NODE_16);
+    memcpy(node16->keys, node4->keys, sizeof(node4->keys));
+    memcpy(node16->children, node4->children, sizeof(node4->children));
+    replaceRadixNode(ref, node, &node16->node);
+    addRadixChild(ref, &node16->node, byte, child);
+    return;
+  }
+
+  case RADIX_NODE_16:
+  {
+    RadixNode16 *node16 = (RadixNode16 *)node;
+    if (node->childCount < 16)
+    {
+      insertSortedRadixChild(node16->keys, node16->children, node->childCount++, byte, child);
+      return;
+    }
+
+    RadixNode48 *node48 = (RadixNode48 *)createRadixNode(RADIX_NODE_48);
+    for (size_t i = 0; i < 16; i++)
+    {
+      node48->childIndex[node16->keys[i]] = i + 1;
+      node48->children[i] = node16->children[i];
+    }
+    replaceRadixNode(ref, node, &node48->node);
+    addRadixChild(ref, &node48->node, byte, child);
+    return;
+  }
+
+  case RADIX_NODE_48:
+  {
+    RadixNode48 *node48 = (RadixNode48 *)node;
+    if (node->childCount < 48)
+    {
+      // removals leave holes so look for a free slot
+      size_t slot = 0;
+      while (node48->children[slot] != NULL)
+        slot++;
+      node48->children[slot] = child;
+      node48->childIndex[byte] = slot + 1;
+      node->childCount++;
+      return;
+    }
+
+    RadixNode256 *node256 = (RadixNode256 *)createRadixNode(RADIX_NODE_256);
+    for (size_t i = 0; i < 256; i++)
+      if (node48->childIndex[i] != 0)
+        node256->children[i] = node48->children[node48->childIndex[i] - 1];
+    replaceRadixNode(ref, node, &node256->node);
+    addRadixChild(ref, &node256->node, byte, child);
+    return;
+  }
+
+  case RADIX_NODE_256:
+    ((RadixNode256 *)node)->children[byte] = child;
+    node->childCount++;
+    return;
+  }
+}
+
+void addRadixLeaf(void **ref, RadixLeaf *leaf, size_t depth)
+{
+  RadixNode *node = *ref;
+  if (leaf->keyLength == depth)
+    node->leaf = leaf;
+  else
+    addRadixChild(ref, node, leaf->key[depth], TAG_RADIX_LEAF(leaf));
+}
+
+void removeRadixChild(RadixNode *node, unsigned char byte)
+{
+  switch (node->type)
+  {
+  case RADIX_NODE_4:
+  case RADIX_NODE_16:
+  {
+    unsigned char *keys = node->type == RADIX_NODE_4 ? ((RadixNode4 *)node)->keys : ((RadixNode16 *)node)->keys;
+    void **children = node->type == RADIX_NODE_4 ? ((RadixNode4 *)node)->children : ((RadixNode16 *)node)->children;
+
+    size_t i = 0;
+    while (keys[i] != byte)
+      i++;
+    for (; i + 1 < node->childCount; i++)
+    {
+      keys[i] = keys[i + 1];
+      children[i] = children[i + 1];
+    }
+    break;
+  }
+
+  case RADIX_NODE_48:
+  {
+    RadixNode48 *node48 = (RadixNode48 *)node;
+    node48->children[node48->childIndex[byte] - 1] = NULL;
+    node48->childIndex[byte] = 0;
+    break;
+  }
+
+  case RADIX_NODE_256:
+    ((RadixNode256 *)node)->children[byte] = NULL;
+    break;
+  }
+  node->childCount--;
+}
+
+void shrinkRadixNode(void **ref)
+{
+  // shrink a bit below the growth thresholds so alternating inserts and removes don't thrash
+  RadixNode *node = *ref;
+  switch (node->type)
+  {
+  case RADIX_NODE_4:
+  {
+    RadixNode4 *node4 = (RadixNode4 *)node;
+    if (node->childCount == 0)
+    {
+      *ref = node->leaf != NULL ? TAG_RADIX_LEAF(node->leaf) : NULL;
+      free(node);
+    }
+    else if (node->childCount == 1 && node->leaf == NULL)
+    {
+      // a single child doesn't need a node, the path is compressed into the child's prefix
+      void *child = node4->children[0];
+      if (!IS_RADIX_LEAF(child))
+      {
+        RadixNode *below = child;
+        unsigned char prefix[RADIX_TREE_MAX_PREFIX];
+        size_t length = MIN_RADIX(node->prefixLength, RADIX_TREE_MAX_PREFIX);
+        memcpy(prefix, node->prefix, length);
+        if (length < RADIX_TREE_MAX_PREFIX)
+          prefix[length++] = node4->keys[0];
+        for (size_t i = 0; i < below->prefixLength && length < RADIX_TREE_MAX_PREFIX; i++)
+          prefix[length++] = below->prefix[i];
+
+        memcpy(below->prefix, prefix, length);
+        below->prefixLength += node->prefixLength + 1;
+      }
+      *ref = child;
+      free(node);
+    }
+    return;
+  }
+
+  case RADIX_NODE_16:
+  {
+    if (node->childCount > 3)
+      return;
+
+    RadixNode16 *node16 = (RadixNode16 *)node;
+    RadixNode4 *node4 = (RadixNode4 *)createRadixNode(RADIX_NODE_4);
+    memcpy(node4->keys, node16->keys, node->childCount);
+    memcpy(node4->children, node16->children, node->childCount * sizeof(void *));
+    replaceRadixNode(ref, node, &node4->node);
+    return;
+  }
+
+  case RADIX_NODE_48:
+  {
+    if (node->childCount > 12)
+      return;
+
+    RadixNode48 *node48 = (RadixNode48 *)node;
+    RadixNode16 *node16 = (RadixNode16 *)createRadixNode(RADIX_NODE_16);
+    size_t count = 0;
+    for (size_t i = 0; i < 256; i++)
+    {
+      if (node48->childIndex[i] != 0)
+      {
+        node16->keys[count] = i;
+        node16->children[count++] = node48->children[node48->childIndex[i] - 1];
+      }
+    }
+    replaceRadixNode(ref, node, &node16->node);
+    return;
+  }
+
+  case RADIX_NODE_256:
+  {
+    if (node->childCount > 36)
+      return;
+
+    RadixNode256 *node256 = (RadixNode256 *)node;
+    RadixNode48 *node48 = (RadixNode48 *)createRadixNode(RADIX_NODE_48);
+    size_t count = 0;
+    for (size_t i = 0; i < 256; i++)
+    {
+      if (node256->children[i] != NULL)
+      {
+        node48->children[count] = node256->children[i];
+        node48->childIndex[i] = ++count;
+      }
+    }
+    replaceRadixNode(ref, node, &node48->node);
+    return;
+  }
+  }
+}
+
+void *insertRadixNode(RadixTree *tree, void **ref, const unsigned char *key, size_t keyLength, void *value,
+                      size_t depth)
+{
+  if (*ref == NULL)
+  {
+    *ref = TAG_RADIX_LEAF(createRadixLeaf(key, keyLength, value));
+    tree->size++;
+    return NULL;
+  }
+
+  if (IS_RADIX_LEAF(*ref))
+  {
+    RadixLeaf *leaf = UNTAG_RADIX_LEAF(*ref);
+    if (matchesRadixLeaf(leaf, key, keyLength))
+    {
+      void *replaced = leaf->value;
+      leaf->value = value;
+      return replaced;
+    }
+
+    // replace the leaf by a node holding both keys below their common prefix
+    size_t limit = MIN_RADIX(leaf->keyLength, keyLength) - depth;
+    size_t common = 0;
+    while (common < limit && leaf->key[depth + common] == key[depth + common])
+      common++;
+
+    RadixNode *node = createRadixNode(RADIX_NODE_4);
+    node->prefixLength = common;
+    if (common != 0)
+      memcpy(node->prefix, key + depth, MIN_RADIX(common, RADIX_TREE_MAX_PREFIX));
+
+    *ref = node;
+    addRadixLeaf(ref, leaf, depth + common);
+    addRadixLeaf(ref, createRadixLeaf(key, keyLength, value), depth + common);
+    tree->size++;
+    return NULL;
+  }
+
+  RadixNode *node = *ref;
+  size_t matched = matchRadixPrefix(node, key, keyLength, depth);
+  if (matched < node->prefixLength)
+  {
+    // the key leaves the compressed path, split it where they differ
+    RadixNode *parent = createRadixNode(RADIX_NODE_4);
+    parent->prefixLength = matched;
+    if (matched != 0)
+      memcpy(parent->prefix, key + depth, MIN_RADIX(matched, RADIX_TREE_MAX_PREFIX));
+
+    unsigned char byte;
+    if (node->prefixLength <= RADIX_TREE_MAX_PREFIX)
+    {
+      byte = node->prefix[matched];
+      node->prefixLength -= matched + 1;
+      memmove(node->prefix, node->prefix + matched + 1, node->prefixLength);
+    }
+    else
+    {
+      // the rest of the prefix isn't stored, take it back from a leaf
+      RadixLeaf *leaf = minimumRadixLeaf(node);
+      byte = leaf->key[depth + matched];
+      node->prefixLength -= matched + 1;
+      memcpy(node->prefix, leaf->key + depth + matched + 1, MIN_RADIX(node->prefixLength, RADIX_TREE_MAX_PREFIX));
+    }
+
+    *ref = parent;
+    addRadixChild(ref, parent, byte, node);
+    addRadixLeaf(ref, createRadixLeaf(key, keyLength, value), depth + matched);
+    tree->size++;
+    return NULL;
+  }
+
+  depth += node->prefixLength;
+  if (depth == keyLength)
+  {
+    if (node->leaf != NULL)
+    {
+      void *replaced = node->leaf->value;
+      node->leaf->value = value;
+      return replaced;
+    }
+
+    node->leaf = createRadixLeaf(key, keyLength, value);
+    tree->size++;
+    return NULL;
+  }
+
+  void **child = findRadixChild(node, key[depth]);
+  if (child != NULL)
+    return insertRadixNode(tree, child, key, keyLength, value, depth + 1);
+
+  addRadixChild(ref, node, key[depth], TAG_RADIX_LEAF(createRadixLeaf(key, keyLength, value)));
+  tree->size++;
+  return NULL;
+}
+
+void *insert_RadixTree(RadixTree *tree, const void *key, size_t keyLength, void *value)
+{
+  return insertRadixNode(tree, &tree->root, key, keyLength, value, 0);
+}
+
+void *search_RadixTree(RadixTree *tree, const void *key, size_t keyLength)
+{
+  const unsigned char *bytes = key;
+  void *child = tree->root;
+  size_t depth = 0;
+
+  while (child != NULL)
+  {
+    if (IS_RADIX_LEAF(child))
+    {
+      RadixLeaf *leaf = UNTAG_RADIX_LEAF(child);
+      return matchesRadixLeaf(leaf, bytes, keyLength) ? leaf->value : NULL;
+    }
+
+    // only the stored bytes of the prefix are checked, the leaf's whole key is compared at the end anyway
+    RadixNode *node = child;
+    if (keyLength - depth < node->prefixLength)
+      return NULL;
+    size_t stored = MIN_RADIX(node->prefixLength, RADIX_TREE_MAX_PREFIX);
+    if (stored != 0 && memcmp(node->prefix, bytes + depth, stored) != 0)
+      return NULL;
+
+    depth += node->prefixLength;
+    if (depth == keyLength)
+      return node->leaf != NULL && matchesRadixLeaf(node->leaf, bytes, keyLength) ? node->leaf->value : NULL;
+
+    void **ref = findRadixChild(node, bytes[depth]);
+    if (ref == NULL)
+      return NULL;
+    child = *ref;
+    depth++;
+  }
+  return NULL;
+}
+
+RadixLeaf *removeRadixNode(void **ref, const unsigned char *key, size_t keyLength, size_t depth)
+{
+  // leaves are removed by their parent, it has to forget their key byte
+  RadixNode *node = *ref;
+  if (keyLength - depth < node->prefixLength)
+    return NULL;
+  size_t stored = MIN_RADIX(node->prefixLength, RADIX_TREE_MAX_PREFIX);
+  if (stored != 0 && memcmp(node->prefix, key + depth, stored) != 0)
+    return NULL;
+
+  depth += node->prefixLength;
+  if (depth == keyLength)
+  {
+    RadixLeaf *leaf = node->leaf;
+    if (leaf == NULL || !matchesRadixLeaf(leaf, key, keyLength))
+      return NULL;
+    node->leaf = NULL;
+    shrinkRadixNode(ref);
+    return leaf;
+  }
+
+  void **child = findRadixChild(node, key[depth]);
+  if (child == NULL)
+    return NULL;
+
+  if (!IS_RADIX_LEAF(*child))
+    return removeRadixNode(child, key, keyLength, depth + 1);
+
+  RadixLeaf *leaf = UNTAG_RADIX_LEAF(*child);
+  if (!matchesRadixLeaf(leaf, key, keyLength))
+    return NULL;
+  removeRadixChild(node, key[depth]);
+  shrinkRadixNode(ref);
+  return leaf;
+}
+
+void *remove_RadixTree(RadixTree *tree, const void *key, size_t keyLength)
+{
+  if (tree->root == NULL)
+    return NULL;
+
+  RadixLeaf *leaf;
+  if (IS_RADIX_LEAF(tree->root))
+  {
+    leaf = UNTAG_RADIX_LEAF(tree->root);
+    if (!matchesRadixLeaf(leaf, key, keyLength))
+      return NULL;
+    tree->root = NULL;
+  }
+  else
+  {
+    leaf = removeRadixNode(&tree->root, key, keyLength, 0);
+    if (leaf == NULL)
+      return NULL;
+  }
+
+  void *value = leaf->value;
+  free(leaf);
+  tree->size--;
+  return value;
+}
+
+void encodeRadixInteger(uint64_t key, unsigned char *bytes)
+{
+  // big-endian so the bytes compare in the same order as the integers
+  for (size_t i = 0; i < 8; i++)
+    bytes[i] = key >> (56 - i * 8);
+}
+
+void *insertInteger_RadixTree(RadixTree *tree, uint64_t key, void *value)
+{
+  unsigned char bytes[8];
+  encodeRadixInteger(key, bytes);
+  return tree->insert(tree, bytes, sizeof(bytes), value);
+}
+
+void *searchInteger_RadixTree(RadixTree *tree, uint64_t key)
+{
+  unsigned char bytes[8];
+  encodeRadixInteger(key, bytes);
+  return tree->search(tree, bytes, sizeof(bytes));
+}
+
+void *removeInteger_RadixTree(RadixTree *tree, uint64_t key)
+{
+  unsigned char bytes[8];
+  encodeRadixInteger(key, bytes);
+  return tree->remove(tree, bytes, sizeof(bytes));
+}
+
+void *findRadixPrefix(RadixTree *tree, const unsigned char *prefix, size_t prefixLength)
+{
+  // returns the node or leaf whose keys all start with the prefix
+  void *child = tree->root;
+  size_t depth = 0;
+
+  while (child != NULL)
+  {
+    if (IS_RADIX_LEAF(child))
+    {
+      RadixLeaf *leaf = UNTAG_RADIX_LEAF(child);
+      if (leaf->keyLength < prefixLength || (prefixLength != 0 && memcmp(leaf->key, prefix, prefixLength) != 0))
+        return NULL;
+      return child;
+    }
+
+    RadixNode *node = child;
+    size_t matched = matchRadixPrefix(node, prefix, prefixLength, depth);
+    if (depth + matched == prefixLength)
+      return child;
+    if (matched < node->prefixLength)
+      return NULL;
+
+    depth += node->prefixLength;
+    void **ref = findRadixChild(node, prefix[depth]);
+    if (ref == NULL)
+      return NULL;
+    child = *ref;
+    depth++;
+  }
+  return NULL;
+}
+
+void visitRadixNode(void *child, void (*visitFn)(const unsigned char *key, size_t keyLength, void *value),
+                    Array *values)
+{
+  // the values are either added to the array or passed to visitFn
+  if (IS_RADIX_LEAF(child))
+  {
+    RadixLeaf *leaf = UNTAG_RADIX_LEAF(child);
+    if (values != NULL)
+      values->add(values, leaf->value);
+    else
+      visitFn(leaf->key, leaf->keyLength, leaf->value);
+    return;
+  }
+
+  RadixNode *node = child;
+  if (node->leaf != NULL)
+    visitRadixNode(TAG_RADIX_LEAF(node->leaf), visitFn, values);
+
+  switch (node->type)
+  {
+  case RADIX_NODE_4:
+    for (size_t i = 0; i < node->childCount; i++)
+      visitRadixNode(((RadixNode4 *)node)->children[i], visitFn, values);
+    break;
+
+  case RADIX_NODE_16:
+    for (size_t i = 0; i < node->childCount; i++)
+      visitRadixNode(((RadixNode16 *)node)->children[i], visitFn, values);
+    break;
+
+  case RADIX_NODE_48:
+  {
+    RadixNode48 *node48 = (RadixNode48 *)node;
+    for (size_t i = 0; i < 256; i++)
+      if (node48->childIndex[i] != 0)
+        visitRadixNode(node48->children[node48->childIndex[i] - 1], visitFn, values);
+    break;
+  }
+
+  case RADIX_NODE_256:
+  {
+    RadixNode256 *node256 = (RadixNode256 *)node;
+    for (size_t i = 0; i < 256; i++)
+      if (node256->children[i] != NULL)
+        visitRadixNode(node256->children[i], visitFn, values);
+    break;
+  }
+  }
+}
+
+Array *prefixScan_RadixTree(RadixTree *tree, const void *prefix, size_t prefixLength)
+{
+  Array *values = createArray();
+  void *child = findRadixPrefix(tree, prefix, prefixLength);
+  if (child != NULL)
+    visitRadixNode(child, NULL, values);
+  return values;
+}
+
+void forEachPrefix_RadixTree(RadixTree *tree, const void *prefix, size_t prefixLength,
+                             void (*visitFn)(const unsigned char *key, size_t keyLength, void *value))
+{
+  void *child = findRadixPrefix(tree, prefix, prefixLength);
+  if (child != NULL)
+    visitRadixNode(child, visitFn, NULL);
+}
+
+void forEach_RadixTree(RadixTree *tree, void (*visitFn)(const unsigned char *key, size_t keyLength, void *value))
+{
+  if (tree->root != NULL)
+    visitRadixNode(tree->root, visitFn, NULL);
+}
+
+void destroyRadixNode(void *child, void (*destroyElementFn)(void *element))
+{
+  if (IS_RADIX_LEAF(child))
+  {
+    RadixLeaf *leaf = UNTAG_RADIX_LEAF(child);
+    if (destroyElementFn != NULL)
+      destroyElementFn(leaf->value);
+    free(leaf);
+    return;
+  }
+
+  RadixNode *node = child;
+  if (node->leaf != NULL)
+    destroyRadixNode(TAG_RADIX_LEAF(node->leaf), destroyElementFn);
+
+  switch (node->type)
+  {
+  case RADIX_NODE_4:
+    for (size_t i = 0; i < node->childCount; i++)
+      destroyRadixNode(((RadixNode4 *)node)->children[i], destroyElementFn);
+    break;
+
+  case RADIX_NODE_16:
+    for (size_t i = 0; i < node->childCount; i++)
+      destroyRadixNode(((RadixNode16 *)node)->children[i], destroyElementFn);
+    break;
+
+  case RADIX_NODE_48:
+  {
+    RadixNode48 *node48 = (RadixNode48 *)node;
+    for (size_t i = 0; i < 48; i++)
+      if (node48->children[i] != NULL)
+        destroyRadixNode(node48->children[i], destroyElementFn);
+    break;
+  }
+
+  case RADIX_NODE_256:
+  {
+    RadixNode256 *node256 = (RadixNode256 *)node;
+    for (size_t i = 0; i < 256; i++)
+      if (node256->children[i] != NULL)
+        destroyRadixNode(node256->children[i], destroyElementFn);
+    break;
+  }
+  }
+  free(node);
+}
+
+void destroy_RadixTree(RadixTree *tree, void (*destroyElementFn)(void *element))
+{
+  if (tree->root != NULL)
+    destroyRadixNode(tree->root, destroyElementFn);
+  free(tree);
+}
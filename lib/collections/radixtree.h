@@ -0,0 +1,208 @@
+#ifndef COLLECTIONS_RADIXTREE_H
+#define COLLECTIONS_RADIXTREE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "array.h"
+
+/**
+ * Number of prefix bytes stored in each node, longer prefixes are checked
+ * against the keys of the leaves instead.
+ */
+#define RADIX_TREE_MAX_PREFIX 8
+
+/**
+ * \brief The kind of an inner node of a RadixTree, named after its capacity.
+ */
+typedef enum RadixNodeType
+{
+  RADIX_NODE_4,  /**< Up to 4 children, sorted keys searched linearly. */
+  RADIX_NODE_16, /**< Up to 16 children, sorted keys searched linearly. */
+  RADIX_NODE_48, /**< Up to 48 children, indexed through a 256-byte table. */
+  RADIX_NODE_256 /**< Up to 256 children, indexed directly by the key byte. */
+} RadixNodeType;
+
+/**
+ * \struct RadixLeaf
+ * \brief A key-value pair stored in a RadixTree.
+ */
+typedef struct RadixLeaf
+{
+  void *value;         /**< Pointer to the value of the key. */
+  size_t keyLength;    /**< Length of the key in bytes. */
+  unsigned char key[]; /**< The whole key. */
+} RadixLeaf;
+
+/**
+ * \struct RadixNode
+ * \brief The header shared by all the inner nodes of a RadixTree.
+ *
+ * The children are pointers either to another node or to a leaf, the leaves
+ * are tagged by setting the lowest bit of the pointer.
+ */
+typedef struct RadixNode
+{
+  RadixNodeType type;                          /**< The kind of node. */
+  size_t childCount;                           /**< Number of children. */
+  size_t prefixLength;                         /**< Length of the compressed path above the children. */
+  unsigned char prefix[RADIX_TREE_MAX_PREFIX]; /**< The first bytes of the compressed path. */
+  RadixLeaf *leaf;                             /**< The key ending right at this node, NULL if none. */
+} RadixNode;
+
+/**
+ * \struct RadixNode4
+ * \brief An inner node with up to 4 children.
+ */
+typedef struct RadixNode4
+{
+  RadixNode node;        /**< The node header. */
+  unsigned char keys[4]; /**< The key byte of each child, sorted. */
+  void *children[4];     /**< The children. */
+} RadixNode4;
+
+/**
+ * \struct RadixNode16
+ * \brief An inner node with up to 16 children.
+ */
+typedef struct RadixNode16
+{
+  RadixNode node;         /**< The node header. */
+  unsigned char keys[16]; /**< The key byte of each child, sorted. */
+  void *children[16];     /**< The children. */
+} RadixNode16;
+
+/**
+ * \struct RadixNode48
+ * \brief An inner node with up to 48 children.
+ */
+typedef struct RadixNode48
+{
+  RadixNode node;                /**< The node header. */
+  unsigned char childIndex[256]; /**< Index + 1 in children of each key byte, 0 if none. */
+  void *children[48];            /**< The children. */
+} RadixNode48;
+
+/**
+ * \struct RadixNode256
+ * \brief An inner node with up to 256 children.
+ */
+typedef struct RadixNode256
+{
+  RadixNode node;      /**< The node header. */
+  void *children[256]; /**< The child of each key byte, NULL if none. */
+} RadixNode256;
+
+/**
+ * \struct RadixTree
+ * \brief An adaptive radix tree (ART) mapping byte string keys to values.
+ *
+ * The keys are looked up byte by byte so every operation is O(key length),
+ * whatever the number of keys. The inner nodes grow and shrink between 4, 16,
+ * 48 and 256 children to stay compact and the paths with a single child are
+ * compressed into a prefix. The keys are kept in lexicographic order.
+ *
+ * Any byte string is a valid key, including keys which are the prefix of
+ * other keys.
+ */
+typedef struct RadixTree
+{
+  void *root;  /**< Pointer to the root node or leaf, NULL if empty. */
+  size_t size; /**< Number of keys in the tree. */
+
+  /**
+   * \brief Inserts a key-value pair, replacing the value if the key is
+   *        already in the tree.
+   * \param tree This tree.
+   * \param key The key, copied into the tree.
+   * \param keyLength The length of the key in bytes.
+   * \param value The value of the key.
+   * \return The replaced value, or NULL if the key wasn't in the tree.
+   * \warning It is up to the caller to free the replaced value.
+   */
+  void *(*insert)(struct RadixTree *tree, const void *key, size_t keyLength, void *value);
+
+  /**
+   * \brief Returns the value of a key.
+   * \param tree This tree.
+   * \param key The key to find.
+   * \param keyLength The length of the key in bytes.
+   * \return The value of the key, or NULL if the key is not in the tree.
+   */
+  void *(*search)(struct RadixTree *tree, const void *key, size_t keyLength);
+
+  /**
+   * \brief Removes a key from the tree.
+   * \param tree This tree.
+   * \param key The key to remove.
+   * \param keyLength The length of the key in bytes.
+   * \return The value of the removed key, or NULL if the key wasn't in the
+   *         tree.
+   * \warning It is up to the caller to free the removed value.
+   */
+  void *(*remove)(struct RadixTree *tree, const void *key, size_t keyLength);
+
+  /**
+   * \brief Same as insert with an integer key.
+   *
+   * The integer is stored as 8 big-endian bytes so the integer keys are
+   * ordered numerically.
+   */
+  void *(*insertInteger)(struct RadixTree *tree, uint64_t key, void *value);
+
+  /**
+   * \brief Same as search with an integer key.
+   */
+  void *(*searchInteger)(struct RadixTree *tree, uint64_t key);
+
+  /**
+   * \brief Same as remove with an integer key.
+   */
+  void *(*removeInteger)(struct RadixTree *tree, uint64_t key);
+
+  /**
+   * \brief Returns the values of all the keys starting with a prefix.
+   * \param tree This tree.
+   * \param prefix The prefix of the keys.
+   * \param prefixLength The length of the prefix in bytes, 0 for all the keys.
+   * \return A new array of the values, ordered by key.
+   * \warning It is up to the caller to destroy the returned array (without
+   *          destroying its elements, they're still in the tree).
+   */
+  Array *(*prefixScan)(struct RadixTree *tree, const void *prefix, size_t prefixLength);
+
+  /**
+   * \brief Visits all the keys starting with a prefix in order.
+   * \param tree This tree.
+   * \param prefix The prefix of the keys.
+   * \param prefixLength The length of the prefix in bytes, 0 for all the keys.
+   * \param visitFn The function called with each key-value pair.
+   * \warning Do not modify the tree while visiting it.
+   */
+  void (*forEachPrefix)(struct RadixTree *tree, const void *prefix, size_t prefixLength,
+                        void (*visitFn)(const unsigned char *key, size_t keyLength, void *value));
+
+  /**
+   * \brief Visits all the keys in order.
+   * \param tree This tree.
+   * \param visitFn The function called with each key-value pair.
+   * \warning Do not modify the tree while visiting it.
+   */
+  void (*forEach)(struct RadixTree *tree, void (*visitFn)(const unsigned char *key, size_t keyLength, void *value));
+
+  /**
+   * \brief Frees the tree from memory.
+   * \param tree This tree.
+   * \param destroyElementFn The function used to free each value.
+   * \warning destroyElementFn is mandatory to avoid memory leaks, however,
+   *          it can be NULL.
+   */
+  void (*destroy)(struct RadixTree *tree, void (*destroyElementFn)(void *element));
+} RadixTree;
+
+/**
+ * \brief Creates a new empty radix tree.
+ * \return The new radix tree.
+ */
+RadixTree *createRadixTree();
+
+#endif // COLLECTIONS_RADIXTREE_H
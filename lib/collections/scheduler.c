@@ -0,0 +1,215 @@
+#include "scheduler.h"
+#include <stdlib.h>
+#include <sched.h>
+
+// rounds of finding nothing to do before a worker parks
+#define SCHEDULER_SPIN_ROUNDS 64
+
+// the worker running on this thread, NULL outside the workers
+_Thread_local SchedulerWorker *currentWorker = NULL;
+
+void *runSchedulerWorker(void *argument);
+SchedulerTask *findSchedulerTask(SchedulerWorker *worker, size_t *victim);
+bool hasSchedulerTask(Scheduler *scheduler);
+void idleScheduler(Scheduler *scheduler, size_t *idleRounds);
+void wakeScheduler(Scheduler *scheduler);
+
+void submit_Scheduler(Scheduler *scheduler, void (*taskFn)(void *argument), void *argument);
+void wait_Scheduler(Scheduler *scheduler);
+void destroy_Scheduler(Scheduler *scheduler);
+
+Scheduler *createScheduler(size_t workerCount)
+{
+  Scheduler *scheduler = malloc(sizeof(Scheduler));
+  scheduler->workerCount = workerCount != 0 ? workerCount : 1;
+  scheduler->workers = malloc(sizeof(SchedulerWorker) * scheduler->workerCount);
+  scheduler->injected = createLinkedList();
+  pthread_mutex_init(&scheduler->injectedLock, NULL);
+  atomic_init(&scheduler->injectedCount, 0);
+  atomic_init(&scheduler->pending, 0);
+  atomic_init(&scheduler->stopping, false);
+  pthread_mutex_init(&scheduler->idleLock, NULL);
+  pthread_cond_init(&scheduler->workAvailable, NULL);
+  pthread_cond_init(&scheduler->allDone, NULL);
+  atomic_init(&scheduler->parked, 0);
+
+  scheduler->submit = submit_Scheduler;
+  scheduler->wait = wait_Scheduler;
+  scheduler->destroy = destroy_Scheduler;
+
+  // all the deques must exist before any worker tries to steal from them
+  for (size_t i = 0; i < scheduler->workerCount; i++)
+  {
+    scheduler->workers[i].scheduler = scheduler;
+    scheduler->workers[i].deque = createWorkDeque();
+    scheduler->workers[i].index = i;
+  }
+  for (size_t i = 0; i < scheduler->workerCount; i++)
+    pthread_create(&scheduler->workers[i].thread, NULL, runSchedulerWorker, &scheduler->workers[i]);
+
+  return scheduler;
+}
+
+void *runSchedulerWorker(void *argument)
+{
+  SchedulerWorker *worker = argument;
+  Scheduler *scheduler = worker->scheduler;
+  currentWorker = worker;
+
+  size_t victim = worker->index;
+  size_t idleRounds = 0;
+  while (!atomic_load_explicit(&scheduler->stopping, memory_order_acquire))
+  {
+    SchedulerTask *task = findSchedulerTask(worker, &victim);
+    if (task == NULL)
+    {
+      idleScheduler(scheduler, &idleRounds);
+      continue;
+    }
+
+    idleRounds = 0;
+    task->taskFn(task->argument);
+    free(task);
+
+    // the waiting threads check pending under the lock so they can't miss this
+    if (atomic_fetch_sub_explicit(&scheduler->pending, 1, memory_order_acq_rel) == 1)
+    {
+      pthread_mutex_lock(&scheduler->idleLock);
+      pthread_cond_broadcast(&scheduler->allDone);
+      pthread_mutex_unlock(&scheduler->idleLock);
+    }
+  }
+
+  currentWorker = NULL;
+  return NULL;
+}
+
+SchedulerTask *findSchedulerTask(SchedulerWorker *worker, size_t *victim)
+{
+  Scheduler *scheduler = worker->scheduler;
+
+  // first our own tasks, newest first since they're still hot in the cache
+  SchedulerTask *task = worker->deque->pop(worker->deque);
+  if (task != NULL)
+    return task;
+
+  // then steal the oldest tasks of the others, starting with the last victim
+  for (size_t i = 0; i < scheduler->workerCount; i++)
+  {
+    *victim = (*victim + 1) % scheduler->workerCount;
+    if (*victim == worker->index)
+      continue;
+
+    WorkDeque *deque = scheduler->workers[*victim].deque;
+    task = deque->steal(deque);
+    if (task != NULL)
+      return task;
+  }
+
+  // finally the tasks submitted from outside
+  if (atomic_load_explicit(&scheduler->injectedCount, memory_order_acquire) == 0)
+    return NULL;
+
+  pthread_mutex_lock(&scheduler->injectedLock);
+  task = scheduler->injected->removeBeg(scheduler->injected);
+  if (task != NULL)
+    atomic_fetch_sub_explicit(&scheduler->injectedCount, 1, memory_order_release);
+  pthread_mutex_unlock(&scheduler->injectedLock);
+  return task;
+}
+
+bool hasSchedulerTask(Scheduler *scheduler)
+{
+  if (atomic_load_explicit(&scheduler->injectedCount, memory_order_relaxed) != 0)
+    return true;
+  for (size_t i = 0; i < scheduler->workerCount; i++)
+    if (scheduler->workers[i].deque->size(scheduler->workers[i].deque) != 0)
+      return true;
+  return false;
+}
+
+void idleScheduler(Scheduler *scheduler, size_t *idleRounds)
+{
+  // spin a little before parking, more tasks are usually on their way
+  if (*idleRounds < SCHEDULER_SPIN_ROUNDS)
+  {
+    (*idleRounds)++;
+    sched_yield();
+    return;
+  }
+
+  // announce we're parking before checking for tasks one last time, either
+  // this check sees a task submitted meanwhile or its submitter sees us parked
+  pthread_mutex_lock(&scheduler->idleLock);
+  atomic_fetch_add_explicit(&scheduler->parked, 1, memory_order_seq_cst);
+  atomic_thread_fence(memory_order_seq_cst);
+  if (!hasSchedulerTask(scheduler) && !atomic_load_explicit(&scheduler->stopping, memory_order_acquire))
+    pthread_cond_wait(&scheduler->workAvailable, &scheduler->idleLock);
+  atomic_fetch_sub_explicit(&scheduler->parked, 1, memory_order_relaxed);
+  pthread_mutex_unlock(&scheduler->idleLock);
+  *idleRounds = 0;
+}
+
+void wakeScheduler(Scheduler *scheduler)
+{
+  // pairs with the fence of idleScheduler, see there
+  atomic_thread_fence(memory_order_seq_cst);
+  if (atomic_load_explicit(&scheduler->parked, memory_order_relaxed) == 0)
+    return;
+
+  pthread_mutex_lock(&scheduler->idleLock);
+  pthread_cond_signal(&scheduler->workAvailable);
+  pthread_mutex_unlock(&scheduler->idleLock);
+}
+
+void submit_Scheduler(Scheduler *scheduler, void (*taskFn)(void *argument), void *argument)
+{
+  SchedulerTask *task = malloc(sizeof(SchedulerTask));
+  task->taskFn = taskFn;
+  task->argument = argument;
+  atomic_fetch_add_explicit(&scheduler->pending, 1, memory_order_acq_rel);
+
+  // Case: submitted from one of our workers, no lock needed
+  if (currentWorker != NULL && currentWorker->scheduler == scheduler)
+  {
+    currentWorker->deque->push(currentWorker->deque, task);
+    wakeScheduler(scheduler);
+    return;
+  }
+
+  // Case: submitted from outside
+  pthread_mutex_lock(&scheduler->injectedLock);
+  scheduler->injected->append(scheduler->injected, task);
+  atomic_fetch_add_explicit(&scheduler->injectedCount, 1, memory_order_release);
+  pthread_mutex_unlock(&scheduler->injectedLock);
+  wakeScheduler(scheduler);
+}
+
+void wait_Scheduler(Scheduler *scheduler)
+{
+  pthread_mutex_lock(&scheduler->idleLock);
+  while (atomic_load_explicit(&scheduler->pending, memory_order_acquire) != 0)
+    pthread_cond_wait(&scheduler->allDone, &scheduler->idleLock);
+  pthread_mutex_unlock(&scheduler->idleLock);
+}
+
+void destroy_Scheduler(Scheduler *scheduler)
+{
+  wait_Scheduler(scheduler);
+  atomic_store_explicit(&scheduler->stopping, true, memory_order_release);
+  pthread_mutex_lock(&scheduler->idleLock);
+  pthread_cond_broadcast(&scheduler->workAvailable);
+  pthread_mutex_unlock(&scheduler->idleLock);
+  for (size_t i = 0; i < scheduler->workerCount; i++)
+    pthread_join(scheduler->workers[i].thread, NULL);
+
+  for (size_t i = 0; i < scheduler->workerCount; i++)
+    scheduler->workers[i].deque->destroy(scheduler->workers[i].deque, free);
+  scheduler->injected->destroy(scheduler->injected, free);
+  pthread_mutex_destroy(&scheduler->injectedLock);
+  pthread_mutex_destroy(&scheduler->idleLock);
+  pthread_cond_destroy(&scheduler->workAvailable);
+  pthread_cond_destroy(&scheduler->allDone);
+  free(scheduler->workers);
+  free(scheduler);
+}
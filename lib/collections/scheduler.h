@@ -0,0 +1,94 @@
+#ifndef COLLECTIONS_SCHEDULER_H
+#define COLLECTIONS_SCHEDULER_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "workdeque.h"
+#include "linkedlist.h"
+
+/**
+ * \struct SchedulerTask
+ * \brief A task to run on a Scheduler.
+ */
+typedef struct SchedulerTask
+{
+  void (*taskFn)(void *argument); /**< The function to run. */
+  void *argument;                 /**< The argument to pass to the function. */
+} SchedulerTask;
+
+/**
+ * \struct SchedulerWorker
+ * \brief A worker thread of a Scheduler with its own deque of tasks.
+ */
+typedef struct SchedulerWorker
+{
+  struct Scheduler *scheduler; /**< The scheduler the worker belongs to. */
+  WorkDeque *deque;            /**< The tasks of the worker, stolen by the others when they run out. */
+  pthread_t thread;            /**< The thread of the worker. */
+  size_t index;                /**< Index of the worker in the scheduler. */
+} SchedulerWorker;
+
+/**
+ * \struct Scheduler
+ * \brief A thread pool balancing its tasks with work-stealing.
+ *
+ * Each worker pushes the tasks it submits to its own WorkDeque without any
+ * lock and runs them in LIFO order. A worker running out of tasks steals the
+ * oldest ones from the other workers. Only the tasks submitted from outside
+ * the workers go through a shared (locked) queue. Workers finding nothing to
+ * steal for a while park until a task is submitted, so an idle scheduler
+ * doesn't use any CPU.
+ */
+typedef struct Scheduler
+{
+  SchedulerWorker *workers; /**< The workers of the scheduler. */
+  size_t workerCount;       /**< Number of workers. */
+
+  LinkedList *injected;          /**< The tasks submitted from outside the workers. */
+  pthread_mutex_t injectedLock;  /**< Guards the injected tasks. */
+  atomic_size_t injectedCount;   /**< Number of injected tasks, to avoid locking for nothing. */
+  atomic_size_t pending;         /**< Number of tasks submitted but not done yet. */
+  atomic_bool stopping;          /**< Whether the workers must stop. */
+  pthread_mutex_t idleLock;      /**< Guards parking the idle workers and the waiting threads. */
+  pthread_cond_t workAvailable;  /**< Signaled when a task is submitted or the workers must stop. */
+  pthread_cond_t allDone;        /**< Broadcast when the last pending task is done. */
+  atomic_size_t parked;          /**< Number of workers waiting for work, to avoid signaling for nothing. */
+
+  /**
+   * \brief Submits a task to run on the scheduler.
+   *
+   * From a worker (i.e. inside a task), the task is pushed to the worker's
+   * own deque. From any other thread, it's added to the shared queue.
+   *
+   * \param scheduler This scheduler.
+   * \param taskFn The function to run.
+   * \param argument The argument to pass to the function.
+   */
+  void (*submit)(struct Scheduler *scheduler, void (*taskFn)(void *argument), void *argument);
+
+  /**
+   * \brief Waits until all the submitted tasks (and the tasks they submitted)
+   *        are done.
+   * \param scheduler This scheduler.
+   * \warning Do not call this from inside a task.
+   */
+  void (*wait)(struct Scheduler *scheduler);
+
+  /**
+   * \brief Waits for all the tasks then stops the workers and frees the
+   *        scheduler from memory.
+   * \param scheduler This scheduler.
+   */
+  void (*destroy)(struct Scheduler *scheduler);
+} Scheduler;
+
+/**
+ * \brief Creates a new scheduler and starts its workers.
+ * \param workerCount The number of worker threads, at least 1.
+ * \return The new scheduler.
+ */
+Scheduler *createScheduler(size_t workerCount);
+
+#endif // COLLECTIONS_SCHEDULER_H
@@ -0,0 +1,133 @@
+#include "sort.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define RADIX_MASK (RADIX_BUCKETS - 1)
+
+void toOffsetsRadix(size_t *counts);
+
+void radixSortUint32(uint32_t *keys, size_t size)
+{
+  if (size < 2)
+    return;
+
+  // count every byte of every key in a single pass
+  size_t counts[sizeof(uint32_t)][RADIX_BUCKETS] = {0};
+  for (size_t i = 0; i < size; i++)
+    for (size_t byte = 0; byte < sizeof(uint32_t); byte++)
+      counts[byte][(keys[i] >> (byte * RADIX_BITS)) & RADIX_MASK]++;
+
+  // ping-pong between the keys and the buffer instead of copying back
+  uint32_t *buffer = malloc(sizeof(uint32_t) * size);
+  uint32_t *source = keys;
+  uint32_t *destination = buffer;
+
+  for (size_t byte = 0; byte < sizeof(uint32_t); byte++)
+  {
+    size_t shift = byte * RADIX_BITS;
+
+    // skip the pass if all the keys have the same byte, it wouldn't move anything
+    if (counts[byte][(source[0] >> shift) & RADIX_MASK] == size)
+      continue;
+
+    toOffsetsRadix(counts[byte]);
+    for (size_t i = 0; i < size; i++)
+      destination[counts[byte][(source[i] >> shift) & RADIX_MASK]++] = source[i];
+
+    uint32_t *swap = source;
+    source = destination;
+    destination = swap;
+  }
+
+  if (source != keys)
+    memcpy(keys, source, sizeof(uint32_t) * size);
+  free(buffer);
+}
+
+void radixSortUint64(uint64_t *keys, size_t size)
+{
+  radixSortPairs(keys, NULL, size);
+}
+
+void radixSortInt32(int32_t *keys, size_t size)
+{
+  // flipping the sign bit orders the negatives before the positives
+  uint32_t *unsignedKeys = (uint32_t *)keys;
+  for (size_t i = 0; i < size; i++)
+    unsignedKeys[i] ^= UINT32_C(1) << 31;
+  radixSortUint32(unsignedKeys, size);
+  for (size_t i = 0; i < size; i++)
+    unsignedKeys[i] ^= UINT32_C(1) << 31;
+}
+
+void radixSortInt64(int64_t *keys, size_t size)
+{
+  uint64_t *unsignedKeys = (uint64_t *)keys;
+  for (size_t i = 0; i < size; i++)
+    unsignedKeys[i] ^= UINT64_C(1) << 63;
+  radixSortUint64(unsignedKeys, size);
+  for (size_t i = 0; i < size; i++)
+    unsignedKeys[i] ^= UINT64_C(1) << 63;
+}
+
+void radixSortPairs(uint64_t *keys, void **values, size_t size)
+{
+  if (size < 2)
+    return;
+
+  size_t counts[sizeof(uint64_t)][RADIX_BUCKETS] = {0};
+  for (size_t i = 0; i < size; i++)
+    for (size_t byte = 0; byte < sizeof(uint64_t); byte++)
+      counts[byte][(keys[i] >> (byte * RADIX_BITS)) & RADIX_MASK]++;
+
+  uint64_t *keysBuffer = malloc(sizeof(uint64_t) * size);
+  void **valuesBuffer = values != NULL ? malloc(sizeof(void *) * size) : NULL;
+  uint64_t *sourceKeys = keys, *destinationKeys = keysBuffer;
+  void **sourceValues = values, **destinationValues = valuesBuffer;
+
+  for (size_t byte = 0; byte < sizeof(uint64_t); byte++)
+  {
+    size_t shift = byte * RADIX_BITS;
+    if (counts[byte][(sourceKeys[0] >> shift) & RADIX_MASK] == size)
+      continue;
+
+    toOffsetsRadix(counts[byte]);
+    for (size_t i = 0; i < size; i++)
+    {
+      size_t index = counts[byte][(sourceKeys[i] >> shift) & RADIX_MASK]++;
+      destinationKeys[index] = sourceKeys[i];
+      if (values != NULL)
+        destinationValues[index] = sourceValues[i];
+    }
+
+    uint64_t *swapKeys = sourceKeys;
+    sourceKeys = destinationKeys;
+    destinationKeys = swapKeys;
+    void **swapValues = sourceValues;
+    sourceValues = destinationValues;
+    destinationValues = swapValues;
+  }
+
+  if (sourceKeys != keys)
+  {
+    memcpy(keys, sourceKeys, sizeof(uint64_t) * size);
+    if (values != NULL)
+      memcpy(values, sourceValues, sizeof(void *) * size);
+  }
+  free(keysBuffer);
+  free(valuesBuffer);
+}
+
+void toOffsetsRadix(size_t *counts)
+{
+  // turn the count of each bucket into its starting offset
+  size_t offset = 0;
+  for (size_t bucket = 0; bucket < RADIX_BUCKETS; bucket++)
+  {
+    size_t count = counts[bucket];
+    counts[bucket] = offset;
+    offset += count;
+  }
+}
@@ -0,0 +1,55 @@
+#ifndef COLLECTIONS_SORT_H
+#define COLLECTIONS_SORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * \brief Sorts 32-bit unsigned integers in ascending order.
+ *
+ * Uses an LSD radix sort (one byte per pass) which is O(n) and never calls a
+ * comparator. The passes where every key has the same byte are skipped.
+ *
+ * \param keys The integers to sort.
+ * \param size The number of integers.
+ */
+void radixSortUint32(uint32_t *keys, size_t size);
+
+/**
+ * \brief Sorts 64-bit unsigned integers in ascending order.
+ * \param keys The integers to sort.
+ * \param size The number of integers.
+ * \see radixSortUint32
+ */
+void radixSortUint64(uint64_t *keys, size_t size);
+
+/**
+ * \brief Sorts 32-bit signed integers in ascending order.
+ * \param keys The integers to sort.
+ * \param size The number of integers.
+ * \see radixSortUint32
+ */
+void radixSortInt32(int32_t *keys, size_t size);
+
+/**
+ * \brief Sorts 64-bit signed integers in ascending order.
+ * \param keys The integers to sort.
+ * \param size The number of integers.
+ * \see radixSortUint32
+ */
+void radixSortInt64(int64_t *keys, size_t size);
+
+/**
+ * \brief Sorts values by their 64-bit unsigned keys in ascending order.
+ *
+ * Both the keys and the values are reordered. The sort is stable, values with
+ * equal keys keep their relative order.
+ *
+ * \param keys The keys to sort by.
+ * \param values The values to sort along with their keys.
+ * \param size The number of keys and values.
+ * \see radixSortUint32
+ */
+void radixSortPairs(uint64_t *keys, void **values, size_t size);
+
+#endif // COLLECTIONS_SORT_H
@@ -0,0 +1,45 @@
+#include "stats.h"
+#include <string.h>
+
+void resetCollectionStats(CollectionStats *stats)
+{
+  memset(stats, 0, sizeof(CollectionStats));
+}
+
+void recordScanCollectionStats(CollectionStats *stats, size_t length)
+{
+  // bucket = floor(log2(length + 1))
+  size_t bucket = 0;
+  for (size_t bound = length + 1; bound > 1 && bucket < COLLECTIONS_STATS_BUCKETS - 1; bound >>= 1)
+    bucket++;
+
+  stats->scans++;
+  stats->scanLength += length;
+  stats->scanHistogram[bucket]++;
+}
+
+void dumpCollectionStats(CollectionStats *stats, const char *name, FILE *stream)
+{
+  fprintf(stream, "%s:\n", name);
+  fprintf(stream, "  adds:        %zu\n", stats->adds);
+  fprintf(stream, "  inserts:     %zu\n", stats->inserts);
+  fprintf(stream, "  removes:     %zu\n", stats->removes);
+  fprintf(stream, "  lookups:     %zu\n", stats->lookups);
+  fprintf(stream, "  accesses:    %zu\n", stats->accesses);
+  fprintf(stream, "  allocations: %zu\n", stats->allocations);
+  fprintf(stream, "  bytes moved: %zu\n", stats->bytesMoved);
+  fprintf(stream, "  scans:       %zu (average length %.2f)\n", stats->scans,
+          stats->scans == 0 ? 0.0 : (double)stats->scanLength / stats->scans);
+
+  for (size_t i = 0; i < COLLECTIONS_STATS_BUCKETS; i++)
+  {
+    if (stats->scanHistogram[i] == 0)
+      continue;
+
+    size_t low = ((size_t)1 << i) - 1;
+    if (i == COLLECTIONS_STATS_BUCKETS - 1)
+      fprintf(stream, "    %zu+: %zu\n", low, stats->scanHistogram[i]);
+    else
+      fprintf(stream, "    %zu-%zu: %zu\n", low, ((size_t)1 << (i + 1)) - 2, stats->scanHistogram[i]);
+  }
+}
@@ -0,0 +1,74 @@
+#ifndef COLLECTIONS_STATS_H
+#define COLLECTIONS_STATS_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * Number of buckets of the scan length histogram.
+ */
+#define COLLECTIONS_STATS_BUCKETS 16
+
+/**
+ * \struct CollectionStats
+ * \brief Counters of the operations done on a collection.
+ *
+ * The collections only record these when compiled with COLLECTIONS_STATS
+ * defined (e.g. -DCOLLECTIONS_STATS), otherwise they don't even have a stats
+ * field and recording them costs nothing.
+ *
+ * \warning Every file including the collections must be compiled with the
+ *          same COLLECTIONS_STATS setting since it changes their layout.
+ */
+typedef struct CollectionStats
+{
+  size_t adds;        /**< Number of elements added at either end. */
+  size_t inserts;     /**< Number of elements inserted at an index. */
+  size_t removes;     /**< Number of elements removed. */
+  size_t lookups;     /**< Number of searches for an element (indexOf). */
+  size_t accesses;    /**< Number of accesses by index (at). */
+  size_t allocations; /**< Number of (re)allocations done. */
+  size_t bytesMoved;  /**< Number of bytes copied by reallocations and shifts. */
+  size_t scans;       /**< Number of linear scans/walks done. */
+  size_t scanLength;  /**< Total number of elements visited by the scans. */
+
+  /**
+   * Histogram of the scan lengths, bucket i counts the scans which visited
+   * between 2^i - 1 and 2^(i + 1) - 2 elements (the last bucket counts all the
+   * longer ones).
+   */
+  size_t scanHistogram[COLLECTIONS_STATS_BUCKETS];
+} CollectionStats;
+
+/**
+ * \brief Sets all the counters back to 0.
+ * \param stats The counters to reset.
+ */
+void resetCollectionStats(CollectionStats *stats);
+
+/**
+ * \brief Records a linear scan/walk.
+ * \param stats The counters to update.
+ * \param length The number of elements visited by the scan.
+ */
+void recordScanCollectionStats(CollectionStats *stats, size_t length);
+
+/**
+ * \brief Prints the counters in a human-readable form.
+ * \param stats The counters to print.
+ * \param name The name to print them under (e.g. the call site).
+ * \param stream Where to print them (e.g. stderr).
+ */
+void dumpCollectionStats(CollectionStats *stats, const char *name, FILE *stream);
+
+#ifdef COLLECTIONS_STATS
+#define STATS_ADD(collection, counter, amount) ((collection)->stats.counter += (amount))
+#define STATS_SCAN(collection, length) recordScanCollectionStats(&(collection)->stats, (length))
+#define STATS_RESET(collection) resetCollectionStats(&(collection)->stats)
+#else
+#define STATS_ADD(collection, counter, amount) ((void)0)
+#define STATS_SCAN(collection, length) ((void)0)
+#define STATS_RESET(collection) ((void)0)
+#endif
+
+#endif // COLLECTIONS_STATS_H
@@ -0,0 +1,104 @@
+#include "stringbuilder.h"
+#include "dalloc.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+void reserveStringBuilder(StringBuilder *builder, size_t length);
+
+void append_StringBuilder(StringBuilder *builder, const char *string);
+void appendLength_StringBuilder(StringBuilder *builder, const char *string, size_t length);
+void appendChar_StringBuilder(StringBuilder *builder, char character);
+void appendFormat_StringBuilder(StringBuilder *builder, const char *format, ...);
+void clear_StringBuilder(StringBuilder *builder);
+char *toString_StringBuilder(StringBuilder *builder);
+void destroy_StringBuilder(StringBuilder *builder);
+
+StringBuilder *createStringBuilder()
+{
+  StringBuilder *builder = malloc(sizeof(StringBuilder));
+  builder->string = NULL;
+  builder->length = 0;
+  builder->allocSize = 0;
+  reserveStringBuilder(builder, 0);
+  builder->string[0] = '\0';
+
+  builder->append = append_StringBuilder;
+  builder->appendLength = appendLength_StringBuilder;
+  builder->appendChar = appendChar_StringBuilder;
+  builder->appendFormat = appendFormat_StringBuilder;
+  builder->clear = clear_StringBuilder;
+  builder->toString = toString_StringBuilder;
+  builder->destroy = destroy_StringBuilder;
+  return builder;
+}
+
+void reserveStringBuilder(StringBuilder *builder, size_t length)
+{
+  // dalloc makes room for one more character, that is for the '\0'
+  if (length >= builder->allocSize || builder->string == NULL)
+    builder->string = dalloc(builder->string, sizeof(char), length, builder->allocSize);
+}
+
+void append_StringBuilder(StringBuilder *builder, const char *string)
+{
+  appendLength_StringBuilder(builder, string, strlen(string));
+}
+
+void appendLength_StringBuilder(StringBuilder *builder, const char *string, size_t length)
+{
+  reserveStringBuilder(builder, builder->length + length);
+  memcpy(builder->string + builder->length, string, length);
+  builder->length += length;
+  builder->string[builder->length] = '\0';
+}
+
+void appendChar_StringBuilder(StringBuilder *builder, char character)
+{
+  reserveStringBuilder(builder, builder->length + 1);
+  builder->string[builder->length++] = character;
+  builder->string[builder->length] = '\0';
+}
+
+void appendFormat_StringBuilder(StringBuilder *builder, const char *format, ...)
+{
+  va_list arguments;
+  va_list retryArguments;
+  va_start(arguments, format);
+  va_copy(retryArguments, arguments);
+
+  // try to format in the space left first, only retry if it didn't fit
+  size_t available = builder->allocSize - builder->length;
+  int length = vsnprintf(builder->string + builder->length, available, format, arguments);
+  if (length >= 0 && (size_t)length >= available)
+  {
+    reserveStringBuilder(builder, builder->length + length);
+    vsnprintf(builder->string + builder->length, length + 1, format, retryArguments);
+  }
+  if (length > 0)
+    builder->length += length;
+  builder->string[builder->length] = '\0';
+
+  va_end(retryArguments);
+  va_end(arguments);
+}
+
+void clear_StringBuilder(StringBuilder *builder)
+{
+  builder->length = 0;
+  builder->string[0] = '\0';
+}
+
+char *toString_StringBuilder(StringBuilder *builder)
+{
+  char *string = malloc(builder->length + 1);
+  memcpy(string, builder->string, builder->length + 1);
+  return string;
+}
+
+void destroy_StringBuilder(StringBuilder *builder)
+{
+  free(builder->string);
+  free(builder);
+}
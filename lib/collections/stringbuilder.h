@@ -0,0 +1,76 @@
+#ifndef COLLECTIONS_STRINGBUILDER_H
+#define COLLECTIONS_STRINGBUILDER_H
+
+#include <stddef.h>
+
+/**
+ * \struct StringBuilder
+ * \brief A growable string to build strings piece by piece.
+ *
+ * The string is always null-terminated and is reallocated by the multiple
+ * of 2 (see dalloc) so appending is amortized O(1).
+ */
+typedef struct StringBuilder
+{
+  char *string;     /**< The built string, always null-terminated. */
+  size_t length;    /**< Length of the string, excluding the '\0'. */
+  size_t allocSize; /**< Total allocated size for the string. */
+
+  /**
+   * \brief Appends a string.
+   * \param builder This builder.
+   * \param string The null-terminated string to append.
+   */
+  void (*append)(struct StringBuilder *builder, const char *string);
+
+  /**
+   * \brief Appends the first characters of a string.
+   * \param builder This builder.
+   * \param string The string to append.
+   * \param length The number of characters to append.
+   */
+  void (*appendLength)(struct StringBuilder *builder, const char *string, size_t length);
+
+  /**
+   * \brief Appends a single character.
+   * \param builder This builder.
+   * \param character The character to append.
+   */
+  void (*appendChar)(struct StringBuilder *builder, char character);
+
+  /**
+   * \brief Appends a formatted string, just like printf.
+   * \param builder This builder.
+   * \param format The printf format string.
+   * \param ... The values to format.
+   */
+  void (*appendFormat)(struct StringBuilder *builder, const char *format, ...);
+
+  /**
+   * \brief Empties the string while keeping the allocated space.
+   * \param builder This builder.
+   */
+  void (*clear)(struct StringBuilder *builder);
+
+  /**
+   * \brief Returns a copy of the built string.
+   * \param builder This builder.
+   * \return The copy of the string.
+   * \warning It is up to the caller to free the returned string.
+   */
+  char *(*toString)(struct StringBuilder *builder);
+
+  /**
+   * \brief Frees the builder and its string from memory.
+   * \param builder This builder.
+   */
+  void (*destroy)(struct StringBuilder *builder);
+} StringBuilder;
+
+/**
+ * \brief Creates a new empty string builder.
+ * \return The new string builder.
+ */
+StringBuilder *createStringBuilder();
+
+#endif // COLLECTIONS_STRINGBUILDER_H
@@ -0,0 +1,108 @@
+#include "stringpool.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define STRING_POOL_INITIAL_SIZE 64
+
+size_t hashStringPool(const char *string, size_t length);
+StringPoolEntry *findStringPoolEntry(StringPoolEntry *entries, size_t allocSize, const char *string, size_t length,
+                                     size_t hash);
+void growStringPool(StringPool *pool);
+
+const char *intern_StringPool(StringPool *pool, const char *string);
+const char *internLength_StringPool(StringPool *pool, const char *string, size_t length);
+void destroy_StringPool(StringPool *pool);
+
+StringPool *createStringPool()
+{
+  StringPool *pool = malloc(sizeof(StringPool));
+  pool->arena = createArena(0);
+  pool->size = 0;
+  pool->allocSize = STRING_POOL_INITIAL_SIZE;
+  pool->entries = calloc(pool->allocSize, sizeof(StringPoolEntry));
+
+  pool->intern = intern_StringPool;
+  pool->internLength = internLength_StringPool;
+  pool->destroy = destroy_StringPool;
+  return pool;
+}
+
+size_t hashStringPool(const char *string, size_t length)
+{
+  // FNV-1a
+  size_t hash = (size_t)14695981039346656037ULL;
+  for (size_t i = 0; i < length; i++)
+  {
+    hash ^= (unsigned char)string[i];
+    hash *= (size_t)1099511628211ULL;
+  }
+  return hash;
+}
+
+StringPoolEntry *findStringPoolEntry(StringPoolEntry *entries, size_t allocSize, const char *string, size_t length,
+                                     size_t hash)
+{
+  // linear probing, returns either the string's entry or the empty entry
+  // where it would go
+  for (size_t i = hash & (allocSize - 1);; i = (i + 1) & (allocSize - 1))
+  {
+    StringPoolEntry *entry = &entries[i];
+    if (entry->string == NULL)
+      return entry;
+    if (entry->hash == hash && entry->length == length && memcmp(entry->string, string, length) == 0)
+      return entry;
+  }
+}
+
+void growStringPool(StringPool *pool)
+{
+  size_t allocSize = pool->allocSize * 2;
+  StringPoolEntry *entries = calloc(allocSize, sizeof(StringPoolEntry));
+  for (size_t i = 0; i < pool->allocSize; i++)
+  {
+    StringPoolEntry *entry = &pool->entries[i];
+    if (entry->string != NULL)
+      *findStringPoolEntry(entries, allocSize, entry->string, entry->length, entry->hash) = *entry;
+  }
+
+  free(pool->entries);
+  pool->entries = entries;
+  pool->allocSize = allocSize;
+}
+
+const char *intern_StringPool(StringPool *pool, const char *string)
+{
+  return internLength_StringPool(pool, string, strlen(string));
+}
+
+const char *internLength_StringPool(StringPool *pool, const char *string, size_t length)
+{
+  size_t hash = hashStringPool(string, length);
+  StringPoolEntry *entry = findStringPoolEntry(pool->entries, pool->allocSize, string, length, hash);
+  if (entry->string != NULL)
+    return entry->string;
+
+  // keep the table at most half full so the probes stay short
+  if ((pool->size + 1) * 2 > pool->allocSize)
+  {
+    growStringPool(pool);
+    entry = findStringPoolEntry(pool->entries, pool->allocSize, string, length, hash);
+  }
+
+  char *copy = pool->arena->alloc(pool->arena, length + 1);
+  memcpy(copy, string, length);
+  copy[length] = '\0';
+
+  entry->string = copy;
+  entry->length = length;
+  entry->hash = hash;
+  pool->size++;
+  return copy;
+}
+
+void destroy_StringPool(StringPool *pool)
+{
+  pool->arena->destroy(pool->arena);
+  free(pool->entries);
+  free(pool);
+}
@@ -0,0 +1,65 @@
+#ifndef COLLECTIONS_STRINGPOOL_H
+#define COLLECTIONS_STRINGPOOL_H
+
+#include <stddef.h>
+#include "arena.h"
+
+/**
+ * \struct StringPoolEntry
+ * \brief An interned string of a StringPool.
+ */
+typedef struct StringPoolEntry
+{
+  const char *string; /**< The interned string, NULL if the entry is empty. */
+  size_t length;      /**< Length of the string, excluding the '\0'. */
+  size_t hash;        /**< The hash of the string. */
+} StringPoolEntry;
+
+/**
+ * \struct StringPool
+ * \brief A pool of unique strings (string interning).
+ *
+ * Interning a string returns the pool's only copy of it, so two interned
+ * strings are equal if and only if their pointers are equal, no strcmp
+ * needed. The copies are all allocated from a single arena.
+ */
+typedef struct StringPool
+{
+  Arena *arena;             /**< The arena the strings are allocated from. */
+  StringPoolEntry *entries; /**< The hash table of the strings. */
+  size_t size;              /**< Number of strings in the pool. */
+  size_t allocSize;         /**< Number of entries of the hash table (a power of 2). */
+
+  /**
+   * \brief Interns a string.
+   * \param pool This pool.
+   * \param string The null-terminated string to intern.
+   * \return The pool's copy of the string.
+   * \warning Do NOT free or modify the returned string, it belongs to the pool.
+   */
+  const char *(*intern)(struct StringPool *pool, const char *string);
+
+  /**
+   * \brief Interns the first characters of a string.
+   * \param pool This pool.
+   * \param string The string to intern.
+   * \param length The number of characters to intern.
+   * \return The pool's (null-terminated) copy of the string.
+   * \warning Do NOT free or modify the returned string, it belongs to the pool.
+   */
+  const char *(*internLength)(struct StringPool *pool, const char *string, size_t length);
+
+  /**
+   * \brief Frees the pool and all of its strings from memory.
+   * \param pool This pool.
+   */
+  void (*destroy)(struct StringPool *pool);
+} StringPool;
+
+/**
+ * \brief Creates a new empty string pool.
+ * \return The new string pool.
+ */
+StringPool *createStringPool();
+
+#endif // COLLECTIONS_STRINGPOOL_H
@@ -0,0 +1,139 @@
+#include "workdeque.h"
+#include <stdlib.h>
+
+#define WORK_DEQUE_INITIAL_SIZE 64
+
+WorkDequeBuffer *createWorkDequeBuffer(size_t allocSize);
+WorkDequeBuffer *growWorkDeque(WorkDeque *deque, WorkDequeBuffer *buffer, ptrdiff_t top, ptrdiff_t bottom);
+
+void push_WorkDeque(WorkDeque *deque, void *element);
+void *pop_WorkDeque(WorkDeque *deque);
+void *steal_WorkDeque(WorkDeque *deque);
+size_t size_WorkDeque(WorkDeque *deque);
+void destroy_WorkDeque(WorkDeque *deque, void (*destroyElementFn)(void *element));
+
+WorkDeque *createWorkDeque()
+{
+  WorkDeque *deque = malloc(sizeof(WorkDeque));
+  atomic_init(&deque->top, 0);
+  atomic_init(&deque->bottom, 0);
+  atomic_init(&deque->buffer, createWorkDequeBuffer(WORK_DEQUE_INITIAL_SIZE));
+
+  deque->push = push_WorkDeque;
+  deque->pop = pop_WorkDeque;
+  deque->steal = steal_WorkDeque;
+  deque->size = size_WorkDeque;
+  deque->destroy = destroy_WorkDeque;
+  return deque;
+}
+
+WorkDequeBuffer *createWorkDequeBuffer(size_t allocSize)
+{
+  WorkDequeBuffer *buffer = malloc(sizeof(WorkDequeBuffer) + sizeof(_Atomic(void *)) * allocSize);
+  buffer->allocSize = allocSize;
+  buffer->previous = NULL;
+  return buffer;
+}
+
+WorkDequeBuffer *growWorkDeque(WorkDeque *deque, WorkDequeBuffer *buffer, ptrdiff_t top, ptrdiff_t bottom)
+{
+  WorkDequeBuffer *grown = createWorkDequeBuffer(buffer->allocSize * 2);
+  for (ptrdiff_t i = top; i < bottom; i++)
+  {
+    void *element = atomic_load_explicit(&buffer->elements[i & (buffer->allocSize - 1)], memory_order_relaxed);
+    atomic_store_explicit(&grown->elements[i & (grown->allocSize - 1)], element, memory_order_relaxed);
+  }
+
+  // thieves might still be reading the old buffer, it's only freed on destroy
+  grown->previous = buffer;
+  atomic_store_explicit(&deque->buffer, grown, memory_order_release);
+  return grown;
+}
+
+void push_WorkDeque(WorkDeque *deque, void *element)
+{
+  ptrdiff_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+  ptrdiff_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+  WorkDequeBuffer *buffer = atomic_load_explicit(&deque->buffer, memory_order_relaxed);
+
+  if (bottom - top > (ptrdiff_t)buffer->allocSize - 1)
+    buffer = growWorkDeque(deque, buffer, top, bottom);
+
+  // publish the element (and whatever it points to) to the thieves
+  atomic_store_explicit(&buffer->elements[bottom & (buffer->allocSize - 1)], element, memory_order_relaxed);
+  atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_release);
+}
+
+void *pop_WorkDeque(WorkDeque *deque)
+{
+  // reserve the bottom element before looking at the top
+  ptrdiff_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+  WorkDequeBuffer *buffer = atomic_load_explicit(&deque->buffer, memory_order_relaxed);
+  atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+  atomic_thread_fence(memory_order_seq_cst);
+  ptrdiff_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+  // Case: empty
+  if (top > bottom)
+  {
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    return NULL;
+  }
+
+  void *element = atomic_load_explicit(&buffer->elements[bottom & (buffer->allocSize - 1)], memory_order_relaxed);
+
+  // Case: last element, race the thieves for it
+  if (top == bottom)
+  {
+    if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst,
+                                                 memory_order_relaxed))
+      element = NULL;
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+  }
+
+  return element;
+}
+
+void *steal_WorkDeque(WorkDeque *deque)
+{
+  ptrdiff_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+  atomic_thread_fence(memory_order_seq_cst);
+  ptrdiff_t bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+  // Case: empty
+  if (top >= bottom)
+    return NULL;
+
+  WorkDequeBuffer *buffer = atomic_load_explicit(&deque->buffer, memory_order_acquire);
+  void *element = atomic_load_explicit(&buffer->elements[top & (buffer->allocSize - 1)], memory_order_relaxed);
+
+  // Case: the owner or another thief got to it first
+  if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst,
+                                               memory_order_relaxed))
+    return NULL;
+
+  return element;
+}
+
+size_t size_WorkDeque(WorkDeque *deque)
+{
+  ptrdiff_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+  ptrdiff_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+  return bottom > top ? (size_t)(bottom - top) : 0;
+}
+
+void destroy_WorkDeque(WorkDeque *deque, void (*destroyElementFn)(void *element))
+{
+  WorkDequeBuffer *buffer = atomic_load(&deque->buffer);
+  if (destroyElementFn != NULL)
+    for (ptrdiff_t i = atomic_load(&deque->top); i < atomic_load(&deque->bottom); i++)
+      destroyElementFn(atomic_load(&buffer->elements[i & (buffer->allocSize - 1)]));
+
+  while (buffer != NULL)
+  {
+    WorkDequeBuffer *previous = buffer->previous;
+    free(buffer);
+    buffer = previous;
+  }
+  free(deque);
+}
@@ -0,0 +1,84 @@
+#ifndef COLLECTIONS_WORKDEQUE_H
+#define COLLECTIONS_WORKDEQUE_H
+
+#include <stddef.h>
+#include <stdatomic.h>
+
+/**
+ * \struct WorkDequeBuffer
+ * \brief The circular buffer holding the elements of a WorkDeque.
+ */
+typedef struct WorkDequeBuffer
+{
+  size_t allocSize;                 /**< Number of elements the buffer can hold (a power of 2). */
+  struct WorkDequeBuffer *previous; /**< The smaller buffer this one replaced, kept until the deque is destroyed. */
+  _Atomic(void *) elements[];       /**< The elements of the buffer. */
+} WorkDequeBuffer;
+
+/**
+ * \struct WorkDeque
+ * \brief A lock-free work-stealing deque (Chase-Lev).
+ *
+ * A single thread owns the deque and pushes/pops elements at its bottom,
+ * while any other thread can steal elements from its top concurrently. The
+ * circular buffer grows as needed.
+ *
+ * \warning Only the owner thread can call push and pop.
+ * \warning NULL elements can't be pushed since NULL means empty.
+ */
+typedef struct WorkDeque
+{
+  atomic_ptrdiff_t top;              /**< Index of the top (oldest) element, where thieves steal from. */
+  atomic_ptrdiff_t bottom;           /**< Index after the bottom (newest) element, where the owner works. */
+  _Atomic(WorkDequeBuffer *) buffer; /**< The current circular buffer. */
+
+  /**
+   * \brief Pushes an element at the bottom of the deque.
+   * \param deque This deque.
+   * \param element The element to push, must not be NULL.
+   * \warning Only the owner thread can call this.
+   */
+  void (*push)(struct WorkDeque *deque, void *element);
+
+  /**
+   * \brief Pops the element at the bottom of the deque (last in, first out).
+   * \param deque This deque.
+   * \return The popped element, or NULL if the deque is empty.
+   * \warning Only the owner thread can call this.
+   */
+  void *(*pop)(struct WorkDeque *deque);
+
+  /**
+   * \brief Steals the element at the top of the deque (first in, first out).
+   * \param deque This deque.
+   * \return The stolen element, or NULL if the deque is empty or another
+   *         thread got to it first.
+   */
+  void *(*steal)(struct WorkDeque *deque);
+
+  /**
+   * \brief Returns the number of elements in the deque.
+   * \param deque This deque.
+   * \return The number of elements, only an estimate if other threads are
+   *         using the deque at the same time.
+   */
+  size_t (*size)(struct WorkDeque *deque);
+
+  /**
+   * \brief Frees the deque from memory.
+   * \param deque This deque.
+   * \param destroyElementFn The function used to free each element.
+   * \warning No other thread must be using the deque anymore.
+   * \warning destroyElementFn is mandatory to avoid memory leaks, however,
+   *          it can be NULL.
+   */
+  void (*destroy)(struct WorkDeque *deque, void (*destroyElementFn)(void *element));
+} WorkDeque;
+
+/**
+ * \brief Creates a new empty work-stealing deque.
+ * \return The new deque.
+ */
+WorkDeque *createWorkDeque();
+
+#endif // COLLECTIONS_WORKDEQUE_H
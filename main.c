@@ -22,11 +22,16 @@ void destroyInteger(Integer *integer)
 char *stringifyInteger(Integer *integer)
 {
   size_t length = snprintf(NULL, 0, "%d", integer->value);
-  char *integerString = malloc(length);
+  char *integerString = malloc(length + 1);
   sprintf(integerString, "%d", integer->value);
   return integerString;
 }
 
+void appendInteger(StringBuilder *builder, Integer *integer)
+{
+  builder->appendFormat(builder, "%d", integer->value);
+}
+
 int main()
 {
   LinkedList *list = createLinkedList();
@@ -51,6 +56,11 @@ int main()
   printf("List: %s\n", str);
   free(str);
 
+  StringBuilder *builder = createStringBuilder();
+  list->appendTo(list, builder, (void (*)(StringBuilder *, void *))appendInteger);
+  printf("List (builder): %s\n", builder->string);
+  builder->destroy(builder);
+
   printf("List from tail: [");
   for (LinkedNode *current = list->tail; current != NULL; current = current->prev)
   {